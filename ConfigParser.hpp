@@ -1,373 +1,4910 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <list>
 #include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
 #include <type_traits>
+#include <typeinfo>
+#include <unordered_set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+#define CONFIGPARSER_KQUEUE 1
+#include <sys/event.h>
+#endif
+
+// CONFIGPARSER_NO_SIMD `ƃXJ[݂̂g
+#if !defined(CONFIGPARSER_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONFIGPARSER_SSE2 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+#define CONFIGPARSER_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CONFIGPARSER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define CONFIGPARSER_TARGET_AVX2
+#endif
+
+// CONFIGPARSER_STATS `Ɖ͂̌viConfigParser::statsjLɂB`ȂvR[h͎cȂ
+#if defined(CONFIGPARSER_STATS)
+#include <chrono>
+#endif
+
 template<typename T, typename = void>
 class Option; // tH[h錾
 
+/// <summary>
+/// 񋓌^̖O\Bꉻ values  (O, l) ׂƁA̗񋓌^̃IvV
+/// "mode: fast" ̂悤ɖOłݒłi啶ʂȂBl]ǂj
+/// </summary>
+/// <example>
+/// template&lt;&gt; struct EnumNames&lt;Mode&gt; {
+///     static constexpr std::pair&lt;std::string_view, Mode&gt; values[] = {{"fast", Mode::Fast}, {"slow", Mode::Slow}};
+/// };
+/// </example>
+template<typename E>
+struct EnumNames
+{};
+
+namespace config_detail {
+
+/// FNV-1a 64bit
+constexpr uint64_t hash_key(std::string_view key) noexcept
+{
+    uint64_t h = 14695981039346656037ull;
+    for (char c : key) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+inline bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+/// operator>> Ɠlɐ擪̋󔒂ǂݔ΂
+inline std::string_view skip_space(std::string_view str)
+{
+    size_t i = 0;
+    while (i < str.size() && is_space(str[i])) {
+        ++i;
+    }
+    return str.substr(i);
+}
+
+/// from_chars  '+' 󂯕tȂ̂Ŏ菜
+inline std::string_view skip_plus(std::string_view str)
+{
+    if (str.size() > 1 && str[0] == '+' && str[1] != '-') {
+        str.remove_prefix(1);
+    }
+    return str;
+}
+
+template<typename T>
+struct is_char_type
+  : std::integral_constant<bool,
+      std::is_same<T, char>::value || std::is_same<T, signed char>::value
+        || std::is_same<T, unsigned char>::value>
+{};
+
 // =======================
-// OptionBase (^p)
+// Converter (񁨒lAP[ˑ)
 // =======================
-class OptionBase {
-public:
-    virtual void setValue(const std::string& str) = 0;
-    virtual void applyDefault() = 0;
-    virtual ~OptionBase() = default;
+template<typename T, typename = void>
+struct Converter
+{
+    // operator>> `[U[^̓Xg[ŕϊ
+    static bool parse(std::string_view str, T& out)
+    {
+        std::istringstream iss{std::string(str)};
+        T val;
+        iss >> val;
+        if (iss.fail()) {
+            return false;
+        }
+        out = std::move(val);
+        return true;
+    }
 };
 
 template<typename T>
-class Option<
-  T,
-  typename std::enable_if<std::is_same<
-    decltype(std::declval<std::istream&>() >> std::declval<T&>()),
-    std::istream&>::value>::type> : public OptionBase 
+struct Converter<T,
+  typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value
+    && !is_char_type<T>::value>::type>
 {
-public:
-    Option(const std::string& name, T& ref): name_(name), ref_(ref)
-    {}
+    static bool parse(std::string_view str, T& out)
+    {
+        str = skip_plus(skip_space(str));
+        T val;
+        auto res = std::from_chars(str.data(), str.data() + str.size(), val);
+        if (res.ec != std::errc()) {
+            return false;
+        }
+        out = val;
+        return true;
+    }
+};
 
-    template<typename U>
-    Option<T>* default_val(const U& val)
+template<typename T>
+struct Converter<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+    static bool parse(std::string_view str, T& out)
     {
-        std::ostringstream oss;
-        oss << val;
-        defaultVal_ = oss.str();
-        return this;
+        str = skip_plus(skip_space(str));
+        T val;
+        auto res = std::from_chars(str.data(), str.data() + str.size(), val);
+        if (res.ec != std::errc()) {
+            return false;
+        }
+        out = val;
+        return true;
+    }
+};
+
+template<>
+struct Converter<bool>
+{
+    // 0/1 ɉ true/falsei啶j󂯕t
+    static bool parse(std::string_view str, bool& out)
+    {
+        str = skip_space(str);
+        if (str.empty()) {
+            return false;
+        }
+        if (str[0] == '0' || str[0] == '1') {
+            out = str[0] == '1';
+            return true;
+        }
+        auto match = [&](const char* word, size_t len) {
+            if (str.size() < len) {
+                return false;
+            }
+            for (size_t i = 0; i < len; ++i) {
+                if ((str[i] | 0x20) != word[i]) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (match("true", 4)) {
+            out = true;
+            return true;
+        }
+        if (match("false", 5)) {
+            out = false;
+            return true;
+        }
+        return false;
+    }
+};
+
+template<typename T>
+struct Converter<T, typename std::enable_if<is_char_type<T>::value>::type>
+{
+    // operator>>(char&) Ɠ󔒈ȊO1ǂ
+    static bool parse(std::string_view str, T& out)
+    {
+        str = skip_space(str);
+        if (str.empty()) {
+            return false;
+        }
+        out = static_cast<T>(str[0]);
+        return true;
+    }
+};
+
+/// <summary>
+/// str ̐擪 '"' Ή '"' ܂łǂ݁A\" \\ \n \r \t ߂ out ɓ
+/// </summary>
+/// <param name="out">nullptr ȂI[T</param>
+/// <param name="end">ɕ '"' ̎̈ʒu</param>
+/// <returns>false: ĂȂ</returns>
+inline bool parse_quoted(std::string_view str, std::string* out, size_t& end)
+{
+    if (out) {
+        out->clear();
+    }
+    for (size_t i = 1; i < str.size(); ++i) {
+        char c = str[i];
+        if (c == '"') {
+            end = i + 1;
+            return true;
+        }
+        if (c == '\\' && i + 1 < str.size()) {
+            c = str[++i];
+            c = c == 'n' ? '\n' : c == 'r' ? '\r' : c == 't' ? '\t' : c;
+        }
+        if (out) {
+            *out += c;
+        }
+    }
+    return false;
+}
+
+template<>
+struct Converter<std::string>
+{
+    // operator>>(std::string&) Ɠ󔒋؂1ǂށB'"' Ŏn܂Έp̒ǂ
+    static bool parse(std::string_view str, std::string& out)
+    {
+        str = skip_space(str);
+        if (!str.empty() && str[0] == '"') {
+            size_t end = 0;
+            return parse_quoted(str, &out, end);
+        }
+        size_t len = 0;
+        while (len < str.size() && !is_space(str[len])) {
+            ++len;
+        }
+        if (len == 0) {
+            return false;
+        }
+        out.assign(str.data(), len);
+        return true;
+    }
+};
+
+template<typename E, typename = void>
+struct has_enum_names : std::false_type
+{};
+
+template<typename E>
+struct has_enum_names<E, decltype((void)EnumNames<E>::values)> : std::true_type
+{};
+
+constexpr char ascii_lower(char c)
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+/// 啶ʂȂ
+constexpr bool iless(std::string_view a, std::string_view b)
+{
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+        char x = ascii_lower(a[i]);
+        char y = ascii_lower(b[i]);
+        if (x != y) {
+            return x < y;
+        }
+    }
+    return a.size() < b.size();
+}
+
+/// <summary>
+/// EnumNames&lt;E&gt;::values 𖼑Oɕבւ\iRpCɍ\zj
+/// </summary>
+template<typename E>
+struct EnumIndex
+{
+    static constexpr size_t size = std::size(EnumNames<E>::values);
+
+    struct Entry
+    {
+        std::string_view name;
+        E value;
+    };
+
+    static constexpr std::array<Entry, size> build()
+    {
+        std::array<Entry, size> table{};
+        for (size_t i = 0; i < size; ++i) {
+            Entry entry{EnumNames<E>::values[i].first, EnumNames<E>::values[i].second};
+            size_t j = i;
+            for (; j > 0 && iless(entry.name, table[j - 1].name); --j) {
+                table[j] = table[j - 1];
+            }
+            table[j] = entry;
+        }
+        return table;
+    }
+
+    static constexpr std::array<Entry, size> sorted = build();
+
+    /// 񕪒TŖOimۂȂj
+    static bool find(std::string_view name, E& out)
+    {
+        auto it = std::lower_bound(sorted.begin(), sorted.end(), name,
+          [](const Entry& entry, std::string_view key) { return iless(entry.name, key); });
+        if (it == sorted.end() || iless(name, it->name)) {
+            return false;
+        }
+        out = it->value;
+        return true;
+    }
+};
+
+template<typename T>
+struct Converter<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+    // O\ΖOA΁i܂͐Ŏn܂΁jlenumϊ
+    static bool parse(std::string_view str, T& out)
+    {
+        if constexpr (has_enum_names<T>::value) {
+            std::string_view word = skip_space(str);
+            if (!word.empty() && word[0] != '-' && word[0] != '+' && (word[0] < '0' || word[0] > '9')) {
+                size_t len = 0;
+                while (len < word.size() && !is_space(word[len])) {
+                    ++len;
+                }
+                return EnumIndex<T>::find(word.substr(0, len), out);
+            }
+        }
+        typename std::underlying_type<T>::type val;
+        if (!Converter<typename std::underlying_type<T>::type>::parse(str, val)) {
+            return false;
+        }
+        out = static_cast<T>(val);
+        return true;
+    }
+};
+
+// =======================
+// Blob (oCiLbVp̒l̒)
+// =======================
+/// 擪Ɍ^^OtAǂݍݎɌ^̐HႢo
+template<typename T>
+uint64_t type_tag()
+{
+    return hash_key(typeid(T).name());
+}
+
+template<typename T>
+void put_raw(std::string& out, const T& val)
+{
+    out.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template<typename T>
+bool get_raw(std::string_view& data, T& val)
+{
+    if (data.size() < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(&val, data.data(), sizeof(T));
+    data.remove_prefix(sizeof(T));
+    return true;
+}
+
+/// ͖ΉieLXĝ܂܃LbVj
+template<typename T, typename = void>
+struct BlobCodec
+{
+    static bool save(const T&, std::string&)
+    {
+        return false;
+    }
+
+    static bool load(std::string_view, T&)
+    {
+        return false;
+    }
+};
+
+/// Zp^Ɨ񋓌^͂̂܂܂̃oCg
+template<typename T>
+struct BlobCodec<T,
+  typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type>
+{
+    static bool save(const T& val, std::string& out)
+    {
+        put_raw(out, type_tag<T>());
+        put_raw(out, val);
+        return true;
+    }
+
+    static bool load(std::string_view data, T& val)
+    {
+        uint64_t tag;
+        return get_raw(data, tag) && tag == type_tag<T>() && data.size() == sizeof(T)
+          && get_raw(data, val);
+    }
+};
+
+template<>
+struct BlobCodec<std::string>
+{
+    static bool save(const std::string& val, std::string& out)
+    {
+        put_raw(out, type_tag<std::string>());
+        out.append(val);
+        return true;
+    }
+
+    static bool load(std::string_view data, std::string& val)
+    {
+        uint64_t tag;
+        if (!get_raw(data, tag) || tag != type_tag<std::string>()) {
+            return false;
+        }
+        val.assign(data.data(), data.size());
+        return true;
+    }
+};
+
+/// Zp^E񋓌^̃xNg͗vf܂Ƃ߂ăRs[ivector<bool>j
+template<typename T>
+struct BlobCodec<std::vector<T>,
+  typename std::enable_if<(std::is_arithmetic<T>::value || std::is_enum<T>::value)
+    && !std::is_same<T, bool>::value>::type>
+{
+    static bool save(const std::vector<T>& val, std::string& out)
+    {
+        put_raw(out, type_tag<std::vector<T>>());
+        out.append(reinterpret_cast<const char*>(val.data()), val.size() * sizeof(T));
+        return true;
+    }
+
+    static bool load(std::string_view data, std::vector<T>& val)
+    {
+        uint64_t tag;
+        if (!get_raw(data, tag) || tag != type_tag<std::vector<T>>() || data.size() % sizeof(T)) {
+            return false;
+        }
+        val.resize(data.size() / sizeof(T));
+        std::memcpy(val.data(), data.data(), data.size());
+        return true;
+    }
+};
+
+// =======================
+// Formatter (dump p̒l̏o)
+// =======================
+/// JSON ̕񃊃eƂĒǋL
+inline void append_json_string(std::string& out, std::string_view str)
+{
+    out += '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += "\\u00";
+            out += "0123456789abcdef"[(c >> 4) & 0xf];
+            out += "0123456789abcdef"[c & 0xf];
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+template<typename T, typename = void>
+struct has_ostream : std::false_type
+{};
+
+template<typename T>
+struct has_ostream<T, decltype((void)(std::declval<std::ostream&>() << std::declval<const T&>()))>
+  : std::true_type
+{};
+
+/// <summary>
+/// l Converter œǂݖ߂` out ɒǋLBjson Ȃ JSON ̒lƂď
+/// </summary>
+/// <returns>false: oȂ^ioperator&lt;&lt; j</returns>
+template<typename T, typename = void>
+struct Formatter
+{
+    // operator<< ^iJSON ł͕j
+    static bool write(std::string& out, const T& val, bool json)
+    {
+        if constexpr (has_ostream<T>::value) {
+            std::ostringstream oss;
+            oss << val;
+            if (json) {
+                append_json_string(out, oss.str());
+            } else {
+                out += oss.str();
+            }
+            return true;
+        } else {
+            (void)out;
+            (void)val;
+            (void)json;
+            return false;
+        }
+    }
+};
+
+template<typename T>
+struct Formatter<T,
+  typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value
+                          && !is_char_type<T>::value>::type>
+{
+    static bool write(std::string& out, T val, bool json)
+    {
+        if constexpr (std::is_floating_point<T>::value) {
+            if (json && !(val == val && val - val == 0)) {
+                out += "null"; // NaNE JSON ŕ\Ȃ
+                return true;
+            }
+        }
+        char buf[64];
+        auto result = std::to_chars(buf, buf + sizeof(buf), val);
+        out.append(buf, static_cast<size_t>(result.ptr - buf));
+        return true;
+    }
+};
+
+template<>
+struct Formatter<bool>
+{
+    static bool write(std::string& out, bool val, bool)
+    {
+        out += val ? "true" : "false";
+        return true;
+    }
+};
+
+template<typename T>
+struct Formatter<T, typename std::enable_if<is_char_type<T>::value>::type>
+{
+    static bool write(std::string& out, T val, bool json)
+    {
+        char c = static_cast<char>(val);
+        if (json) {
+            append_json_string(out, std::string_view(&c, 1));
+        } else {
+            out += c;
+        }
+        return true;
+    }
+};
+
+template<>
+struct Formatter<std::string>
+{
+    // 1Ƃēǂݖ߂ȂliE󔒂','܂ށE'"'Ŏn܂j͈pň͂
+    static bool write(std::string& out, const std::string& val, bool json)
+    {
+        if (json) {
+            append_json_string(out, val);
+        } else if (needs_quotes(val)) {
+            out += '"';
+            for (char c : val) {
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                    out += c;
+                } else if (c == '\n' || c == '\r' || c == '\t') {
+                    out += '\\';
+                    out += c == '\n' ? 'n' : c == '\r' ? 'r' : 't';
+                } else {
+                    out += c;
+                }
+            }
+            out += '"';
+        } else {
+            out += val;
+        }
+        return true;
+    }
+
+    static bool needs_quotes(std::string_view val)
+    {
+        if (val.empty() || val[0] == '"') {
+            return true;
+        }
+        for (char c : val) {
+            if (is_space(c) || c == ',') {
+                return true;
+            }
+        }
+        return false;
     }
+};
+
+template<typename T>
+struct Formatter<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+    // EnumNames ΖOAΐ
+    static bool write(std::string& out, T val, bool json)
+    {
+        if constexpr (has_enum_names<T>::value) {
+            for (const auto& entry : EnumNames<T>::values) {
+                if (entry.second == val) {
+                    if (json) {
+                        append_json_string(out, entry.first);
+                    } else {
+                        out += entry.first;
+                    }
+                    return true;
+                }
+            }
+        }
+        using U = typename std::underlying_type<T>::type;
+        return Formatter<U>::write(out, static_cast<U>(val), json);
+    }
+};
+
+template<typename T>
+struct Formatter<std::vector<T>>
+{
+    // ','؂iJSON ͔zj
+    static bool write(std::string& out, const std::vector<T>& val, bool json)
+    {
+        if (json) {
+            out += '[';
+        }
+        for (size_t i = 0; i < val.size(); ++i) {
+            if (i > 0) {
+                out += ',';
+            }
+            if (!Formatter<T>::write(out, static_cast<T>(val[i]), json)) {
+                return false;
+            }
+        }
+        if (json) {
+            out += ']';
+        }
+        return true;
+    }
+};
+
+/// E_̃xNgpꊇϊi`͑GW̌j
+template<typename T>
+struct is_batch_number
+  : std::integral_constant<bool,
+      (std::is_integral<T>::value && !std::is_same<T, bool>::value && !is_char_type<T>::value)
+        || std::is_floating_point<T>::value>
+{};
+
+template<typename T>
+bool parse_number_list(std::string_view str, std::vector<T>& out, std::string_view& bad);
+
+/// <summary>
+/// ','؂̕ out ɕϊBvfɐĈxmۂi','͗vfɐȂj
+/// </summary>
+/// <param name="reserve">0ȊOȂmۂvf</param>
+/// <param name="bad">sɕϊłȂvfistr ̈ꕔj</param>
+/// <returns>false: ϊłȂvfiO͑oȂj</returns>
+template<typename T>
+bool try_parse_list(std::string_view str, std::vector<T>& out, size_t reserve, std::string_view& bad)
+{
+    if constexpr (is_batch_number<T>::value) {
+        return parse_number_list(str, out, bad);
+    }
+
+    out.clear();
+    if (!str.empty()) {
+        size_t count = static_cast<size_t>(std::count(str.begin(), str.end(), ','))
+          + (str.back() != ',' ? 1 : 0);
+        out.reserve(reserve > 0 ? reserve : count);
+    }
+
+    // ','؂1pXAvfƂɂ̏ŕϊ
+    size_t pos = 0;
+    while (pos < str.size()) {
+        size_t from = pos;
+        if constexpr (std::is_same<T, std::string>::value) {
+            // p̒ ',' ł͋؂Ȃ
+            std::string_view rest = skip_space(str.substr(pos));
+            size_t end = 0;
+            if (!rest.empty() && rest[0] == '"' && parse_quoted(rest, nullptr, end)) {
+                from = static_cast<size_t>(rest.data() - str.data()) + end;
+            }
+        }
+        size_t comma = str.find(',', from);
+        if (comma == std::string_view::npos) {
+            comma = str.size();
+        }
+        std::string_view token = str.substr(pos, comma - pos);
+        pos = comma + 1;
+
+        T val{};
+        if (!Converter<T>::parse(token, val)) {
+            bad = token;
+            return false;
+        }
+        out.push_back(std::move(val));
+    }
+    return true;
+}
+
+/// try_parse_list ̗O
+template<typename T>
+void parse_list(std::string_view str, std::vector<T>& out, size_t reserve = 0)
+{
+    std::string_view bad;
+    if (!try_parse_list(str, out, reserve, bad)) {
+        throw std::runtime_error("Parse error in vector element: " + std::string(bad));
+    }
+}
+
+/// ^ɉϊizĂяoȂjBs͗O
+template<typename T>
+void assign_value(std::string_view str, T& out)
+{
+    if (!Converter<T>::parse(str, out)) {
+        throw std::runtime_error("Failed to parse value: " + std::string(str));
+    }
+}
+
+template<typename T>
+void assign_value(std::string_view str, std::vector<T>& out)
+{
+    parse_list(str, out);
+}
+
+/// ƂĈ^iconst char*, std::string Ȃǁj
+template<typename U>
+struct is_text
+  : std::integral_constant<bool, std::is_convertible<const U&, std::string_view>::value>
+{};
+
+/// <summary>
+/// l^ T ɈxϊB ConverterAϊ\Ȍ^͂̂܂܁A
+/// ȊO operator<< ŕɂĂ Converter ɓn
+/// </summary>
+template<typename T, typename U>
+T to_default(const U& val)
+{
+    if constexpr (is_text<U>::value && std::is_constructible<T, std::string_view>::value) {
+        return T(std::string_view(val));
+    } else if constexpr (is_text<U>::value) {
+        T out{};
+        if (!Converter<T>::parse(std::string_view(val), out)) {
+            throw std::runtime_error("Failed to parse default value: " + std::string(val));
+        }
+        return out;
+    } else if constexpr (std::is_convertible<const U&, T>::value) {
+        return static_cast<T>(val);
+    } else {
+        std::ostringstream oss;
+        oss << val;
+        return to_default<T>(oss.str());
+    }
+}
+
+/// <summary>
+/// IvVێľ^B̓IvVƓ\[Xmۂ
+/// </summary>
+template<typename T>
+struct DefaultStorage
+{
+    using type = T;
+
+    template<typename U>
+    static type make(const U& val, std::pmr::memory_resource*)
+    {
+        return to_default<T>(val);
+    }
+
+    static void apply(T& out, const type& val)
+    {
+        out = val;
+    }
+
+    static T get(const type& val)
+    {
+        return val;
+    }
+};
+
+template<>
+struct DefaultStorage<std::string>
+{
+    using type = std::pmr::string;
+
+    template<typename U>
+    static type make(const U& val, std::pmr::memory_resource* resource)
+    {
+        if constexpr (is_text<U>::value) {
+            return type(std::string_view(val), resource);
+        } else {
+            return type(to_default<std::string>(val), resource);
+        }
+    }
+
+    /// out ̗eʂg
+    static void apply(std::string& out, const type& val)
+    {
+        out.assign(val.data(), val.size());
+    }
+
+    static std::string get(const type& val)
+    {
+        return std::string(val);
+    }
+};
+
+// =======================
+// InlineFunction (q[vgȂȌĂяo\)
+// =======================
+template<typename Signature, size_t Capacity = 6 * sizeof(void*)>
+class InlineFunction;
+
+/// <summary>
+/// std::function Ɠľ^ACapacity ȉ̌Ăяo\͓̂obt@ɒuB
+/// 傫̂q[vɒuB std::function  nullptr nƋɂȂ
+/// </summary>
+template<typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity>
+{
+public:
+    InlineFunction() = default;
+
+    InlineFunction(std::nullptr_t)
+    {}
+
+    template<typename F,
+      typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, InlineFunction>::value>::type>
+    InlineFunction(F&& f)
+    {
+        using Fn = typename std::decay<F>::type;
+        if constexpr (std::is_constructible<bool, const Fn&>::value) {
+            if (!static_cast<bool>(f)) {
+                return;
+            }
+        }
+        if constexpr (fits<Fn>()) {
+            ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+        } else {
+            *reinterpret_cast<Fn**>(storage_) = new Fn(std::forward<F>(f));
+        }
+        ops_ = &ops<Fn>;
+    }
+
+    InlineFunction(const InlineFunction& other)
+    {
+        if (other.ops_) {
+            other.ops_->copy(other.storage_, storage_);
+            ops_ = other.ops_;
+        }
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept
+    {
+        if (other.ops_) {
+            other.ops_->move(other.storage_, storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+    }
+
+    InlineFunction& operator=(InlineFunction other) noexcept
+    {
+        reset();
+        if (other.ops_) {
+            other.ops_->move(other.storage_, storage_);
+            ops_ = other.ops_;
+            other.ops_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~InlineFunction()
+    {
+        reset();
+    }
+
+    explicit operator bool() const
+    {
+        return ops_ != nullptr;
+    }
+
+    R operator()(Args... args) const
+    {
+        if (!ops_) {
+            throw std::bad_function_call();
+        }
+        return ops_->invoke(storage_, std::forward<Args>(args)...);
+    }
+
+private:
+    struct Ops
+    {
+        R (*invoke)(const unsigned char*, Args&&...);
+        void (*copy)(const unsigned char*, unsigned char*);
+        void (*move)(unsigned char*, unsigned char*); // ړ͔jς݂ɂȂ
+        void (*destroy)(unsigned char*);
+    };
+
+    template<typename Fn>
+    static constexpr bool fits()
+    {
+        return sizeof(Fn) <= Capacity && alignof(Fn) <= alignof(std::max_align_t)
+          && std::is_nothrow_move_constructible<Fn>::value;
+    }
+
+    /// std::function Ɠ const ̌Ăяołg͔ const ŌĂԁimutable _pj
+    template<typename Fn>
+    static Fn& target(const unsigned char* storage)
+    {
+        unsigned char* p = const_cast<unsigned char*>(storage);
+        if constexpr (fits<Fn>()) {
+            return *std::launder(reinterpret_cast<Fn*>(p));
+        } else {
+            return **reinterpret_cast<Fn**>(p);
+        }
+    }
+
+    template<typename Fn>
+    static constexpr Ops ops = {
+        [](const unsigned char* storage, Args&&... args) -> R {
+            return target<Fn>(storage)(std::forward<Args>(args)...);
+        },
+        [](const unsigned char* from, unsigned char* to) {
+            if constexpr (fits<Fn>()) {
+                ::new (static_cast<void*>(to)) Fn(target<Fn>(from));
+            } else {
+                *reinterpret_cast<Fn**>(to) = new Fn(target<Fn>(from));
+            }
+        },
+        [](unsigned char* from, unsigned char* to) {
+            if constexpr (fits<Fn>()) {
+                Fn& source = target<Fn>(from);
+                ::new (static_cast<void*>(to)) Fn(std::move(source));
+                source.~Fn();
+            } else {
+                *reinterpret_cast<Fn**>(to) = *reinterpret_cast<Fn**>(from);
+            }
+        },
+        [](unsigned char* storage) {
+            if constexpr (fits<Fn>()) {
+                target<Fn>(storage).~Fn();
+            } else {
+                delete &target<Fn>(storage);
+            }
+        },
+    };
+
+    void reset()
+    {
+        if (ops_) {
+            ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage_[Capacity];
+    const Ops* ops_ = nullptr;
+};
+
+// =======================
+// ValueSlot (Registry ̔zɕԌ^^OEi[El)
+// =======================
+/// Other ȊO̓IvV{̂ɊlBEnum ͏o{̂ɔC
+enum class ValueKind : uint8_t
+{
+    Other,
+    Signed,
+    Unsigned,
+    Float,
+    Double,
+    Bool,
+    Enum,
+};
+
+template<typename T>
+constexpr ValueKind value_kind()
+{
+    if constexpr (sizeof(T) > sizeof(uint64_t)) {
+        return ValueKind::Other;
+    } else if constexpr (std::is_same<T, bool>::value) {
+        return ValueKind::Bool;
+    } else if constexpr (std::is_enum<T>::value) {
+        return ValueKind::Enum;
+    } else if constexpr (std::is_integral<T>::value && !is_char_type<T>::value) {
+        return std::is_signed<T>::value ? ValueKind::Signed : ValueKind::Unsigned;
+    } else if constexpr (std::is_same<T, float>::value) {
+        return ValueKind::Float;
+    } else if constexpr (std::is_same<T, double>::value) {
+        return ValueKind::Double;
+    } else {
+        return ValueKind::Other;
+    }
+}
+
+struct ValueSlot
+{
+    ValueKind kind = ValueKind::Other;
+    uint8_t size = 0;
+    bool hasDefault = false;
+    void* target = nullptr;
+    uint64_t defaultBits = 0; // l̐擪 size oCg
+
+    /// fallback  DefaultStorage<T>::typeiXJ[ enum ł T ̂́j
+    template<typename T, typename D>
+    void assign(T& variable, const std::optional<D>& fallback)
+    {
+        kind = value_kind<T>();
+        if constexpr (value_kind<T>() != ValueKind::Other) {
+            size = static_cast<uint8_t>(sizeof(T));
+            target = &variable;
+            hasDefault = fallback.has_value();
+            if (hasDefault) {
+                std::memcpy(&defaultBits, &*fallback, sizeof(T));
+            }
+        }
+    }
+
+    /// target ɊliOther ł͉Ȃj
+    void apply_default() const
+    {
+        if (!hasDefault) {
+            return;
+        }
+        // Ƃɒ萔ŃRs[Amemcpy ̌ĂяoɂȂ
+        switch (size) {
+        case 1:
+            std::memcpy(target, &defaultBits, 1);
+            break;
+        case 2:
+            std::memcpy(target, &defaultBits, 2);
+            break;
+        case 4:
+            std::memcpy(target, &defaultBits, 4);
+            break;
+        case 8:
+            std::memcpy(target, &defaultBits, 8);
+            break;
+        default:
+            std::memcpy(target, &defaultBits, size);
+            break;
+        }
+    }
+
+    /// Signed`Bool Ȃ猻ݒloBfalse: IvV{̂ɔC
+    bool write(std::string& out, bool json) const
+    {
+        switch (kind) {
+        case ValueKind::Signed:
+            return Formatter<int64_t>::write(out, load<int8_t, int16_t, int32_t, int64_t>(), json);
+        case ValueKind::Unsigned:
+            return Formatter<uint64_t>::write(out, load<uint8_t, uint16_t, uint32_t, uint64_t>(), json);
+        case ValueKind::Float:
+            return Formatter<float>::write(out, *static_cast<const float*>(target), json);
+        case ValueKind::Double:
+            return Formatter<double>::write(out, *static_cast<const double*>(target), json);
+        case ValueKind::Bool:
+            return Formatter<bool>::write(out, *static_cast<const bool*>(target), json);
+        default:
+            return false;
+        }
+    }
+
+private:
+    /// size ɍ target ǂ݁A64rbgɍL
+    template<typename T1, typename T2, typename T4, typename T8>
+    T8 load() const
+    {
+        switch (size) {
+        case 1:
+            return *static_cast<const T1*>(target);
+        case 2:
+            return *static_cast<const T2*>(target);
+        case 4:
+            return *static_cast<const T4*>(target);
+        default:
+            return *static_cast<const T8*>(target);
+        }
+    }
+};
+
+} // namespace config_detail
+
+/// trySetValue sƂ̓e
+struct ValueError
+{
+    std::string message;
+    std::string_view at; // sӏil̈ꕔBxNgȂYvfj
+};
+
+// =======================
+// OptionBase (^p)
+// =======================
+class OptionBase {
+public:
+    virtual void setValue(std::string_view str) = 0;
+    virtual void applyDefault() = 0;
+    virtual ~OptionBase() = default;
+
+    /// <summary>
+    /// O𑗏oɕϊBcommit  false ȂϐɌ^Ɨvf
+    /// </summary>
+    /// <returns>false: ϊsierror ɓej</returns>
+    virtual bool trySetValue(std::string_view str, bool commit, ValueError& error)
+    {
+        if (!commit) {
+            return true; // ̕@Ȃ^
+        }
+        try {
+            setValue(str);
+            return true;
+        } catch (const std::exception& e) {
+            error.message = e.what();
+            error.at = str;
+            return false;
+        }
+    }
+
+    /// ʃXbh瑼̃IvVƓ setValue Ă悢
+    virtual bool parallelSafe() const
+    {
+        return true;
+    }
+
+    /// ϊς݂̒loCiLbVɏBΉ̌^ false
+    virtual bool save(std::string& out) const
+    {
+        (void)out;
+        return false;
+    }
+
+    /// save ŏoCil𕜌
+    virtual bool load(std::string_view data)
+    {
+        (void)data;
+        return false;
+    }
+
+    /// ݒleLXgijson Ȃ JSON ̒lj out ɒǋLBoȂ^ false
+    virtual bool write(std::string& out, bool json) const
+    {
+        (void)out;
+        (void)json;
+        return false;
+    }
+
+    /// <summary>
+    /// Registry ̔z ValueSlot Ɍ^Ei[ElAȌ̊l̕ύXfB
+    /// z񂪐Lт邽тɐVʒuŌĂђ
+    /// </summary>
+    virtual void bind(config_detail::ValueSlot& slot)
+    {
+        slot = config_detail::ValueSlot();
+    }
+};
+
+template<typename T>
+class Option<
+  T,
+  typename std::enable_if<std::is_same<
+    decltype(std::declval<std::istream&>() >> std::declval<T&>()),
+    std::istream&>::value>::type> : public OptionBase 
+{
+public:
+    /// <param name="name">IvV蒷邱ƁiConfigParser ͎g̃L[\wj</param>
+    Option(std::string_view name, T& ref,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : ref_(ref), name_(name), resource_(resource)
+    {}
+
+    /// l͓o^ T ֕ϊĕێij
+    template<typename U>
+    Option<T>* default_val(const U& val)
+    {
+        default_ = Storage::make(val, resource_);
+        if (slot_) {
+            slot_->assign(ref_, default_);
+        }
+        return this;
+    }
+
+    Option<T>* expected(size_t n)
+    {
+        expectedCount_ = n;
+        return this;
+    }
+
+    void applyDefault() override
+    {
+        if (default_)
+            Storage::apply(ref_, *default_);
+    }
+
+    void setValue(std::string_view str) override
+    {
+        if (!config_detail::Converter<T>::parse(str, ref_)) {
+            throw std::runtime_error("Failed to parse value: " + std::string(str));
+        }
+    }
+
+    bool trySetValue(std::string_view str, bool commit, ValueError& error) override
+    {
+        if (commit) {
+            if (config_detail::Converter<T>::parse(str, ref_)) {
+                return true;
+            }
+        } else {
+            T temp(ref_);
+            if (config_detail::Converter<T>::parse(str, temp)) {
+                return true;
+            }
+        }
+        error.message = "Failed to parse value: " + std::string(str);
+        error.at = str;
+        return false;
+    }
+
+    bool save(std::string& out) const override
+    {
+        return config_detail::BlobCodec<T>::save(ref_, out);
+    }
+
+    bool load(std::string_view data) override
+    {
+        return config_detail::BlobCodec<T>::load(data, ref_);
+    }
+
+    bool write(std::string& out, bool json) const override
+    {
+        return config_detail::Formatter<T>::write(out, ref_, json);
+    }
+
+    const T& value() const
+    {
+        return ref_;
+    }
+
+    /// ϊɒl
+    void assign(const T& value)
+    {
+        ref_ = value;
+    }
+
+    void bind(config_detail::ValueSlot& slot) override
+    {
+        slot = config_detail::ValueSlot();
+        slot.assign(ref_, default_);
+        slot_ = &slot;
+    }
+
+private:
+    using Storage = config_detail::DefaultStorage<T>;
+
+    T& ref_;
+    std::string_view name_;
+    std::pmr::memory_resource* resource_;
+    std::optional<typename Storage::type> default_;
+    size_t expectedCount_ = 0;
+    config_detail::ValueSlot* slot_ = nullptr;
+};
+
+template<typename T>
+class Option<std::vector<T>, void> : public OptionBase 
+{
+public:
+    /// <param name="name">IvV蒷邱ƁiConfigParser ͎g̃L[\wj</param>
+    Option(std::string_view name, std::vector<T>& ref,
+      std::pmr::memory_resource* = std::pmr::get_default_resource())
+      : ref_(ref), name_(name)
+    {}
+
+    /// std::vector<T> A','؂̕io^Ɉxϊj
+    template<typename U>
+    Option<std::vector<T>>* default_val(const U& val)
+    {
+        if constexpr (std::is_convertible<const U&, std::vector<T>>::value
+                      && !config_detail::is_text<U>::value) {
+            default_ = val;
+        } else if constexpr (config_detail::is_text<U>::value) {
+            std::vector<T> list;
+            parseList(std::string_view(val), list);
+            default_ = std::move(list);
+        } else {
+            std::ostringstream oss;
+            oss << val;
+            std::vector<T> list;
+            parseList(oss.str(), list);
+            default_ = std::move(list);
+        }
+        return this;
+    }
+
+    Option<std::vector<T>>* expected(size_t n)
+    {
+        expectedCount_ = n;
+        return this;
+    }
+
+    void applyDefault() override
+    {
+        if (default_) {
+            checkCount(default_->size());
+            ref_ = *default_;
+        }
+    }
+
+    void setValue(std::string_view str) override
+    {
+        parseList(str, ref_);
+        checkCount(ref_.size());
+    }
+
+    /// ̏ꍇ̓XbhƂ̍Ɨ̈ɕϊ
+    bool trySetValue(std::string_view str, bool commit, ValueError& error) override
+    {
+        thread_local std::vector<T> scratch;
+        std::vector<T>& out = commit ? ref_ : scratch;
+        std::string_view bad;
+        if (!config_detail::try_parse_list(str, out, expectedCount_, bad)) {
+            error.message = "Parse error in vector element: " + std::string(bad);
+            error.at = bad;
+            return false;
+        }
+        if (expectedCount_ > 0 && out.size() != expectedCount_) {
+            error.message = "Expected " + std::to_string(expectedCount_) + " elements, got "
+              + std::to_string(out.size());
+            error.at = str;
+            return false;
+        }
+        return true;
+    }
+
+    bool save(std::string& out) const override
+    {
+        return config_detail::BlobCodec<std::vector<T>>::save(ref_, out);
+    }
+
+    bool load(std::string_view data) override
+    {
+        return config_detail::BlobCodec<std::vector<T>>::load(data, ref_);
+    }
+
+    bool write(std::string& out, bool json) const override
+    {
+        return config_detail::Formatter<std::vector<T>>::write(out, ref_, json);
+    }
+
+    const std::vector<T>& value() const
+    {
+        return ref_;
+    }
+
+    /// ϊɒliexpected ̗vf͌j
+    void assign(const std::vector<T>& value)
+    {
+        checkCount(value.size());
+        ref_ = value;
+    }
+
+private:
+    void parseList(std::string_view str, std::vector<T>& out) const
+    {
+        config_detail::parse_list(str, out, expectedCount_);
+    }
+
+    void checkCount(size_t size) const
+    {
+        if (expectedCount_ > 0 && size != expectedCount_) {
+            throw std::runtime_error(
+            "Expected " + std::to_string(expectedCount_) + " elements, got "
+            + std::to_string(size));
+        }
+    }
+
+    std::vector<T>& ref_;
+    std::string_view name_;
+    std::optional<std::vector<T>> default_;
+    size_t expectedCount_ = 0;
+};
+
+template<typename T>
+class Option<T, typename std::enable_if<std::is_enum<T>::value>::type>
+  : public OptionBase 
+{
+public:
+    /// <param name="name">IvV蒷邱ƁiConfigParser ͎g̃L[\wj</param>
+    Option(std::string_view name, T& ref,
+      std::pmr::memory_resource* = std::pmr::get_default_resource())
+      : ref_(ref), name_(name)
+    {}
+
+    /// 񋓒lEÊꂩ
+    template<typename U>
+    Option<T>* default_val(const U& val)
+    {
+        if constexpr (config_detail::is_text<U>::value) {
+            default_ = config_detail::to_default<T>(val);
+        } else {
+            default_ = static_cast<T>(val);
+        }
+        if (slot_) {
+            slot_->assign(ref_, default_);
+        }
+        return this;
+    }
+
+    Option<T>* expected(size_t n)
+    {
+        expectedCount_ = n;
+        return this;
+    }
+
+    void applyDefault() override
+    {
+        if (default_)
+            ref_ = *default_;
+    }
+
+    void setValue(std::string_view str) override
+    {
+        // lA܂ EnumNames œo^Oenumϊ
+        if (!config_detail::Converter<T>::parse(str, ref_)) {
+            throw std::runtime_error("Failed to parse enum value: " + std::string(str));
+        }
+    }
+
+    bool trySetValue(std::string_view str, bool commit, ValueError& error) override
+    {
+        T temp = ref_;
+        if (config_detail::Converter<T>::parse(str, commit ? ref_ : temp)) {
+            return true;
+        }
+        error.message = "Failed to parse enum value: " + std::string(str);
+        error.at = str;
+        return false;
+    }
+
+    bool save(std::string& out) const override
+    {
+        return config_detail::BlobCodec<T>::save(ref_, out);
+    }
+
+    bool load(std::string_view data) override
+    {
+        return config_detail::BlobCodec<T>::load(data, ref_);
+    }
+
+    bool write(std::string& out, bool json) const override
+    {
+        return config_detail::Formatter<T>::write(out, ref_, json);
+    }
+
+    const T& value() const
+    {
+        return ref_;
+    }
+
+    /// ϊɒl
+    void assign(const T& value)
+    {
+        ref_ = value;
+    }
+
+    void bind(config_detail::ValueSlot& slot) override
+    {
+        slot = config_detail::ValueSlot();
+        slot.assign(ref_, default_);
+        slot_ = &slot;
+    }
+
+private:
+    T& ref_;
+    std::string_view name_;
+    std::optional<T> default_;
+    size_t expectedCount_ = 0;
+    config_detail::ValueSlot* slot_ = nullptr;
+};
+
+template<typename T>
+class OptionFunc : public OptionBase {
+public:
+  /// <summary>
+  /// setter / getter ̓_E֐|C^Estd::function ȂǁBĂяo\̂̓q[vg킸ɕێ
+  /// </summary>
+  template<typename Setter, typename Getter>
+  OptionFunc(
+    std::string_view name,
+    Setter&& setter,
+    Getter&& getter,
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+    : name_(name)
+    , defaultVal_(resource)
+    , description_(resource)
+    , setter_(std::forward<Setter>(setter))
+    , getter_(std::forward<Getter>(getter))
+    , steps_(resource)
+  {}
+
+  /// <summary>
+  /// T ̒l͂̂܂ܕێB transform ʂߏ applyDefault ŕϊĕێ
+  /// </summary>
+  template<typename U>
+  OptionFunc* default_val(const U& val)
+  {
+    if constexpr (config_detail::is_text<U>::value) {
+      defaultVal_ = std::string_view(val);
+      default_.reset();
+    } else {
+      default_ = Storage::make(val, defaultVal_.get_allocator().resource());
+      defaultVal_.clear();
+    }
+    return this;
+  }
+
+  OptionFunc* description(const std::string& desc)
+  {
+    description_ = desc;
+    return this;
+  }
+
+  /// <summary>
+  /// 񂩂 T ւ̕ϊuBconv  std::string_view 󂯎΃Rs[ɓn
+  /// iconst std::string& 󂯎ꍇ݈̂ꎞj
+  /// </summary>
+  template<typename Conv>
+  OptionFunc* transform(Conv conv)
+  {
+    if constexpr (std::is_invocable_r<T, Conv&, std::string_view>::value) {
+      parse_ = std::move(conv);
+    } else {
+      parse_ = [conv = std::move(conv)](std::string_view str) mutable { return conv(std::string(str)); };
+    }
+    return this;
+  }
+
+  /// <summary>
+  /// ϊ̒lɓKp鏈iT 󂯎 T Ԃjo^ɒǉB
+  /// ͈͂̊ۂ߂PʊZȂǂ transform Ƒgݍ킹
+  /// </summary>
+  template<typename Step>
+  OptionFunc* then(Step step)
+  {
+    steps_.emplace_back(std::move(step));
+    return this;
+  }
+
+  void setValue(std::string_view str) override
+  {
+    setter_(finish(convert(str)));
+  }
+
+  /// p҂ transform / then oO͕߂܂ error ɂ
+  bool trySetValue(std::string_view str, bool commit, ValueError& error) override
+  {
+    T temp{};
+    if (!parse_ && !config_detail::Converter<T>::parse(str, temp)) {
+      error.message = "Failed to parse value: " + std::string(str);
+      error.at = str;
+      return false;
+    }
+    if (parse_ || !steps_.empty()) {
+      try {
+        temp = finish(parse_ ? parse_(str) : std::move(temp));
+      } catch (const std::exception& e) {
+        error.message = e.what();
+        error.at = str;
+        return false;
+      }
+    }
+    if (commit) {
+      setter_(std::move(temp));
+    }
+    return true;
+  }
+
+  void applyDefault()
+  {
+    if (!default_ && !defaultVal_.empty()) {
+      default_ = Storage::make(finish(convert(defaultVal_)), defaultVal_.get_allocator().resource());
+    }
+    if (default_) {
+      setter_(Storage::get(*default_));
+    }
+  }
+
+  // Zb^[͋LԂɐG邩Ȃ̂ŌĂяoXbhŏɓKp
+  bool parallelSafe() const override
+  {
+    return false;
+  }
+
+  bool save(std::string& out) const override
+  {
+    return getter_ && config_detail::BlobCodec<T>::save(getter_(), out);
+  }
+
+  bool load(std::string_view data) override
+  {
+    T temp{};
+    if (!config_detail::BlobCodec<T>::load(data, temp)) {
+      return false;
+    }
+    setter_(temp);
+    return true;
+  }
+
+  /// ϊɃZb^[֓n
+  void assign(const T& value)
+  {
+    setter_(value);
+  }
+
+  bool write(std::string& out, bool json) const override
+  {
+    return getter_ && config_detail::Formatter<T>::write(out, getter_(), json);
+  }
+
+private:
+  T convert(std::string_view str) const
+  {
+    if (parse_) {
+      return parse_(str);
+    }
+    T temp{};
+    if (!config_detail::Converter<T>::parse(str, temp)) {
+      throw std::runtime_error("Failed to parse value: " + std::string(str));
+    }
+    return temp;
+  }
+
+  T finish(T value) const
+  {
+    for (const auto& step : steps_) {
+      value = step(std::move(value));
+    }
+    return value;
+  }
+
+  using Storage = config_detail::DefaultStorage<T>;
+
+  std::string_view name_;
+  std::pmr::string defaultVal_;
+  std::optional<typename Storage::type> default_; //  defaultVal_ Ɠ\[Xmۂ
+  std::pmr::string description_;
+  config_detail::InlineFunction<void(T)> setter_;
+  config_detail::InlineFunction<T()> getter_;
+  config_detail::InlineFunction<T(std::string_view)> parse_;
+  std::pmr::vector<config_detail::InlineFunction<T(T)>> steps_;
+};
+
+
+
+namespace config_detail {
+
+// =======================
+// OptionDeleter (memory_resource ̃IvVj)
+// =======================
+struct OptionDeleter
+{
+    std::pmr::memory_resource* resource = nullptr;
+    void* block = nullptr;
+    size_t size = 0;
+    size_t align = 0;
+
+    void operator()(OptionBase* opt) const
+    {
+        opt->~OptionBase();
+        resource->deallocate(block, size, align);
+    }
+};
+
+using OptionPtr = std::unique_ptr<OptionBase, OptionDeleter>;
+
+// =======================
+// Registry (o^ς݃IvV̔z)
+// =======================
+/// <summary>
+/// L[EIvVE^^OƊi[Ɗl(ValueSlot)ELo^̘AzɕĎ
+/// i\̂̔zł͂Ȃz̍\́jBXJ[̊l̓KpƏo slots() 
+/// 擪ǂ݁AIvV{̂̉zĂяooRȂ
+/// </summary>
+class Registry
+{
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    explicit Registry(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : keys_(resource)
+      , options_(resource)
+      , slots_(resource)
+      , owners_(resource)
+      , index_(resource)
+    {}
+
+    /// L[o^ς݂Ȃ瓯ʒuŒuAÂIvVԂ
+    /// iĂяo͌ÂIvVwL^tւĂjj
+    OptionPtr add(std::string_view key, OptionPtr option)
+    {
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            options_[it->second] = option.get();
+            std::swap(owners_[it->second], option);
+            options_[it->second]->bind(slots_[it->second]);
+            return option;
+        }
+        // zɑĊmۂApush_back rŎsȂ悤ɂ
+        if (keys_.size() == keys_.capacity() || options_.size() == options_.capacity()
+            || slots_.size() == slots_.capacity() || owners_.size() == owners_.capacity()) {
+            size_t capacity = std::max<size_t>(16, keys_.size() * 2);
+            keys_.reserve(capacity);
+            options_.reserve(capacity);
+            const ValueSlot* old = slots_.data();
+            slots_.reserve(capacity);
+            owners_.reserve(capacity);
+            if (old != slots_.data()) {
+                // eIvVʒuڂɕtւi{XɐL΂̂ŏp O(1)j
+                for (size_t i = 0; i < options_.size(); ++i) {
+                    options_[i]->bind(slots_[i]);
+                }
+            }
+        }
+        index_.emplace(key, static_cast<uint32_t>(keys_.size()));
+        keys_.push_back(key);
+        options_.push_back(option.get());
+        slots_.emplace_back();
+        owners_.push_back(std::move(option));
+        options_.back()->bind(slots_.back());
+        return nullptr;
+    }
+
+    /// o^ʒuA npos
+    size_t find(std::string_view key) const
+    {
+        auto it = index_.find(key);
+        return it != index_.end() ? it->second : npos;
+    }
+
+    size_t size() const
+    {
+        return keys_.size();
+    }
+
+    const std::pmr::vector<std::string_view>& keys() const
+    {
+        return keys_;
+    }
+
+    const std::pmr::vector<OptionBase*>& options() const
+    {
+        return options_;
+    }
+
+    /// options() Ɠт̌^^OEi[El
+    const std::pmr::vector<ValueSlot>& slots() const
+    {
+        return slots_;
+    }
+
+    /// lKpBXJ[ enum ͔z񂾂ǂ݁AȊO̓IvV{̂ɔC
+    void apply_defaults() const
+    {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].kind != ValueKind::Other) {
+                slots_[i].apply_default();
+            } else {
+                options_[i]->applyDefault();
+            }
+        }
+    }
+
+    /// i Ԗڂ̌ݒloBfalse: oȂ^
+    bool write(size_t i, std::string& out, bool json) const
+    {
+        return slots_[i].write(out, json) || options_[i]->write(out, json);
+    }
+
+private:
+    std::pmr::vector<std::string_view> keys_; // L[\w
+    std::pmr::vector<OptionBase*> options_;
+    std::pmr::vector<ValueSlot> slots_;
+    std::pmr::vector<OptionPtr> owners_;      // jɂg
+    std::pmr::unordered_map<std::string_view, uint32_t> index_;
+};
+
+
+// =======================
+// MappedFile (ǂݎpt@Cr[)
+// =======================
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    /// <summary>
+    /// t@C}bvB}bvłȂꍇipCvj͓nhǂݍ
+    /// iFIFO ͊JƏƂ̃yA؂邽߁j
+    /// </summary>
+    /// <param name="path"></param>
+    /// <returns>false: t@CJȂEǂ߂Ȃ</returns>
+    bool open(const char* path)
+    {
+        close();
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr,
+          OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        if (map(file)) {
+            return true; // file_ L
+        }
+        bool ok = read_all(file);
+        CloseHandle(file);
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        bool ok = map(fd) || read_all(fd);
+        ::close(fd); // }bvfdĂ悢
+#endif
+        if (!ok) {
+            close();
+        }
+        return ok;
+    }
+
+    void close()
+    {
+        if (mapped_) {
+#if defined(_WIN32)
+            UnmapViewOfFile(data_);
+            CloseHandle(mapping_);
+            CloseHandle(file_);
+            mapping_ = nullptr;
+            file_ = INVALID_HANDLE_VALUE;
+#else
+            munmap(const_cast<char*>(data_), size_);
+#endif
+            mapped_ = false;
+        }
+        buffer_.clear();
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    std::string_view view() const
+    {
+        return std::string_view(data_, size_);
+    }
+
+private:
+#if defined(_WIN32)
+    ///  file  file_ ƂĕێBs file Ȃ
+    bool map(HANDLE file)
+    {
+        LARGE_INTEGER size;
+        if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &size)
+            || size.QuadPart == 0) {
+            return false;
+        }
+        mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* addr = mapping_ ? MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (!addr) {
+            if (mapping_) CloseHandle(mapping_);
+            mapping_ = nullptr;
+            return false;
+        }
+        file_ = file;
+        data_ = static_cast<const char*>(addr);
+        size_ = static_cast<size_t>(size.QuadPart);
+        mapped_ = true;
+        return true;
+    }
+
+    bool read_all(HANDLE file)
+    {
+        char chunk[64 * 1024];
+        DWORD n = 0;
+        for (;;) {
+            if (!ReadFile(file, chunk, sizeof(chunk), &n, nullptr)) {
+                // pCv̏肪ꍇ͏I[ƂĈ
+                if (GetLastError() != ERROR_BROKEN_PIPE) {
+                    return false;
+                }
+                break;
+            }
+            if (n == 0) {
+                break;
+            }
+            buffer_.append(chunk, n);
+        }
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        return true;
+    }
+#else
+    bool map(int fd)
+    {
+        struct stat st;
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) {
+            return false;
+        }
+        void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            return false;
+        }
+        madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(addr);
+        size_ = static_cast<size_t>(st.st_size);
+        mapped_ = true;
+        return true;
+    }
+
+    bool read_all(int fd)
+    {
+        char chunk[64 * 1024];
+        for (;;) {
+            ssize_t n = ::read(fd, chunk, sizeof(chunk));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            if (n == 0) {
+                break;
+            }
+            buffer_.append(chunk, static_cast<size_t>(n));
+        }
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        return true;
+    }
+#endif
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    bool mapped_ = false;
+    std::string buffer_; // tH[obNp
+#if defined(_WIN32)
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#endif
+};
+
+// =======================
+// FileWatcher (ύXĎAmubLO)
+// =======================
+/// inotify / kqueue / FindFirstChangeNotification gAgȂ΍XV|[O
+class FileWatcher
+{
+public:
+    FileWatcher() = default;
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    /// Ďp̃nh̏Lڂ
+    FileWatcher(FileWatcher&& other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    FileWatcher& operator=(FileWatcher&& other) noexcept
+    {
+        if (this != &other) {
+            close();
+            path_ = std::move(other.path_);
+            name_ = std::move(other.name_);
+            stamp_ = other.stamp_;
+#if defined(__linux__)
+            fd_ = std::exchange(other.fd_, -1);
+#elif defined(CONFIGPARSER_KQUEUE)
+            kq_ = std::exchange(other.kq_, -1);
+            file_ = std::exchange(other.file_, -1);
+#elif defined(_WIN32)
+            handle_ = std::exchange(other.handle_, INVALID_HANDLE_VALUE);
+#endif
+            other.path_.clear();
+        }
+        return *this;
+    }
+
+    ~FileWatcher()
+    {
+        close();
+    }
+
+    void watch(const char* path)
+    {
+        close();
+        path_ = path;
+        stamp_ = stamp();
+        std::filesystem::path file(path_);
+        std::string dir = file.has_parent_path() ? file.parent_path().string() : ".";
+        name_ = file.filename().string();
+#if defined(__linux__)
+        // GfB^̒uۑɂǏ]邽߃fBNgĎ
+        fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (fd_ >= 0 && inotify_add_watch(fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+#elif defined(CONFIGPARSER_KQUEUE)
+        kq_ = kqueue();
+        if (kq_ >= 0 && !add_vnode()) {
+            ::close(kq_);
+            kq_ = -1;
+        }
+#elif defined(_WIN32)
+        handle_ = FindFirstChangeNotificationA(
+          dir.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+#endif
+    }
+
+    /// ǑĂяoȍ~ɕύX
+    bool changed()
+    {
+        if (path_.empty()) {
+            return false;
+        }
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            bool hit = false;
+            alignas(inotify_event) char buf[4096];
+            ssize_t len;
+            while ((len = read(fd_, buf, sizeof(buf))) > 0) {
+                for (char* p = buf; p < buf + len;) {
+                    auto* ev = reinterpret_cast<inotify_event*>(p);
+                    if (ev->len > 0 && name_ == ev->name) {
+                        hit = true;
+                    }
+                    p += sizeof(inotify_event) + ev->len;
+                }
+            }
+            return hit;
+        }
+#elif defined(CONFIGPARSER_KQUEUE)
+        if (kq_ >= 0) {
+            struct kevent ev;
+            struct timespec zero = {0, 0};
+            bool hit = false;
+            while (kevent(kq_, nullptr, 0, &ev, 1, &zero) > 0) {
+                hit = true;
+                if (ev.fflags & (NOTE_DELETE | NOTE_RENAME)) {
+                    // uꂽ̂ŊJ
+                    ::close(file_);
+                    file_ = -1;
+                    add_vnode();
+                }
+            }
+            return hit;
+        }
+#elif defined(_WIN32)
+        if (handle_ != INVALID_HANDLE_VALUE) {
+            if (WaitForSingleObject(handle_, 0) != WAIT_OBJECT_0) {
+                return false;
+            }
+            FindNextChangeNotification(handle_);
+            // fBNg̑t@C̕ύX͍XVŏO
+        }
+#endif
+        auto now = stamp();
+        if (now == stamp_) {
+            return false;
+        }
+        stamp_ = now;
+        return true;
+    }
+
+    void close()
+    {
+#if defined(__linux__)
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+#elif defined(CONFIGPARSER_KQUEUE)
+        if (file_ >= 0) {
+            ::close(file_);
+            file_ = -1;
+        }
+        if (kq_ >= 0) {
+            ::close(kq_);
+            kq_ = -1;
+        }
+#elif defined(_WIN32)
+        if (handle_ != INVALID_HANDLE_VALUE) {
+            FindCloseChangeNotification(handle_);
+            handle_ = INVALID_HANDLE_VALUE;
+        }
+#endif
+        path_.clear();
+    }
+
+private:
+    using Stamp = std::pair<std::filesystem::file_time_type, std::uintmax_t>;
+
+    Stamp stamp() const
+    {
+        std::error_code ec;
+        auto time = std::filesystem::last_write_time(path_, ec);
+        auto size = std::filesystem::file_size(path_, ec);
+        return ec ? Stamp() : Stamp(time, size);
+    }
+
+#if defined(CONFIGPARSER_KQUEUE)
+    bool add_vnode()
+    {
+#if defined(O_EVTONLY)
+        file_ = ::open(path_.c_str(), O_EVTONLY);
+#else
+        file_ = ::open(path_.c_str(), O_RDONLY);
+#endif
+        if (file_ < 0) {
+            return false;
+        }
+        struct kevent ev;
+        EV_SET(&ev, file_, EVFILT_VNODE, EV_ADD | EV_CLEAR,
+          NOTE_WRITE | NOTE_EXTEND | NOTE_DELETE | NOTE_RENAME, 0, nullptr);
+        return kevent(kq_, &ev, 1, nullptr, 0, nullptr) == 0;
+    }
+#endif
+
+    std::string path_;
+    std::string name_;
+    Stamp stamp_;
+#if defined(__linux__)
+    int fd_ = -1;
+#elif defined(CONFIGPARSER_KQUEUE)
+    int kq_ = -1;
+    int file_ = -1;
+#elif defined(_WIN32)
+    HANDLE handle_ = INVALID_HANDLE_VALUE;
+#endif
+};
+
+// =======================
+// GW (SIMD, sfBXpb`)
+// =======================
+inline unsigned count_trailing_zeros(uint64_t x)
+{
+#if defined(_MSC_VER)
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return static_cast<unsigned>(idx);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+}
+
+/// [p, end)  a ܂ b ŏɌʒuԂB end
+using FindPairFunc = const char* (*)(const char* p, const char* end, char a, char b);
+
+inline const char* find_pair_scalar(const char* p, const char* end, char a, char b)
+{
+    for (; p < end; ++p) {
+        if (*p == a || *p == b) {
+            return p;
+        }
+    }
+    return end;
+}
+
+#if defined(CONFIGPARSER_SSE2)
+inline const char* find_pair_sse2(const char* p, const char* end, char a, char b)
+{
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        unsigned mask = static_cast<unsigned>(
+          _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, va), _mm_cmpeq_epi8(v, vb))));
+        if (mask) {
+            return p + count_trailing_zeros(mask);
+        }
+    }
+    return find_pair_scalar(p, end, a, b);
+}
+
+CONFIGPARSER_TARGET_AVX2 inline const char* find_pair_avx2(
+  const char* p, const char* end, char a, char b)
+{
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    for (; end - p >= 32; p += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+          _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb))));
+        if (mask) {
+            return p + count_trailing_zeros(mask);
+        }
+    }
+    return find_pair_sse2(p, end, a, b);
+}
+
+inline bool cpu_has_avx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    // OSYMMWX^ۑ邩mF
+    return osxsave && avx2 && (_xgetbv(0) & 0x6) == 0x6;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+#if defined(CONFIGPARSER_NEON)
+inline const char* find_pair_neon(const char* p, const char* end, char a, char b)
+{
+    const uint8x16_t va = vdupq_n_u8(static_cast<uint8_t>(a));
+    const uint8x16_t vb = vdupq_n_u8(static_cast<uint8_t>(b));
+    for (; end - p >= 16; p += 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+        uint8x16_t eq = vorrq_u8(vceqq_u8(v, va), vceqq_u8(v, vb));
+        // 1oCg4rbg̃}XNɏk߂
+        uint64_t mask = vget_lane_u64(
+          vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        if (mask) {
+            return p + (count_trailing_zeros(mask) >> 2);
+        }
+    }
+    return find_pair_scalar(p, end, a, b);
+}
+#endif
+
+inline FindPairFunc select_find_pair()
+{
+#if defined(CONFIGPARSER_SSE2)
+    return cpu_has_avx2() ? find_pair_avx2 : find_pair_sse2;
+#elif defined(CONFIGPARSER_NEON)
+    return find_pair_neon;
+#else
+    return find_pair_scalar;
+#endif
+}
+
+inline const char* find_pair(const char* p, const char* end, char a, char b)
+{
+    static const FindPairFunc func = select_find_pair();
+    return func(p, end, a, b);
+}
+
+// =======================
+// lXg̈ꊇϊ (vf̓rbg}XNŐAevf1pXŕϊ)
+// =======================
+inline size_t count_char(const char* p, const char* end, char c)
+{
+    size_t count = 0;
+#if defined(CONFIGPARSER_SSE2)
+    const __m128i vc = _mm_set1_epi8(c);
+    for (; end - p >= 16; p += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        count += std::bitset<16>(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, vc)))).count();
+    }
+#endif
+    for (; p < end; ++p) {
+        count += *p == c;
+    }
+    return count;
+}
+
+/// 10̙pƂɐmɕ\͈͂ȂAZ1Őۂ߂ (Clinger  fast path)
+template<typename T>
+struct ExactDecimal;
+
+template<>
+struct ExactDecimal<double>
+{
+    static constexpr uint64_t maxMantissa = uint64_t(1) << 53;
+    static constexpr size_t maxScale = 22;
+    static constexpr double pow10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+template<>
+struct ExactDecimal<float>
+{
+    static constexpr uint64_t maxMantissa = uint64_t(1) << 24;
+    static constexpr size_t maxScale = 10;
+    static constexpr float pow10[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+};
+
+template<typename T>
+struct has_exact_decimal : std::false_type {};
+
+template<>
+struct has_exact_decimal<float> : std::true_type {};
+
+template<>
+struct has_exact_decimal<double> : std::true_type {};
+
+/// <summary>
+/// [p, end) 擪 "[][+|-][.]" ǂ݁Ap 𐔒l̒֐i߂B
+/// Ew\LE͈͊OȂǑoHňȂꍇ falseiĂяo Converter ɔCj
+/// </summary>
+template<typename T>
+bool decode_number(const char*& p, const char* end, T& out)
+{
+    while (p < end && is_space(*p)) {
+        ++p;
+    }
+    if (end - p > 1 && *p == '+' && p[1] != '-') {
+        ++p;
+    }
+    bool negative = p < end && *p == '-';
+    p += negative;
+    const char* digits = p;
+    uint64_t val = 0;
+    while (p < end && static_cast<unsigned char>(*p - '0') < 10) {
+        val = val * 10 + static_cast<unsigned>(*p - '0');
+        ++p;
+    }
+    size_t count = static_cast<size_t>(p - digits);
+    if (count - 1 >= 18) {
+        return false; // A܂ uint64_t Ɏ܂ȂȂ
+    }
+
+    if constexpr (std::is_integral<T>::value) {
+        using Limits = std::numeric_limits<T>;
+        if (negative) {
+            if (std::is_unsigned<T>::value
+                || val > static_cast<uint64_t>(-(static_cast<int64_t>(Limits::min()) + 1)) + 1) {
+                return false;
+            }
+            out = static_cast<T>(-static_cast<int64_t>(val));
+        } else {
+            if (val > static_cast<uint64_t>(Limits::max())) {
+                return false;
+            }
+            out = static_cast<T>(val);
+        }
+        return true;
+    } else {
+        size_t scale = 0;
+        if (p < end && *p == '.') {
+            const char* fraction = ++p;
+            while (p < end && static_cast<unsigned char>(*p - '0') < 10 && count < 18) {
+                val = val * 10 + static_cast<unsigned>(*p - '0');
+                ++p;
+                ++count;
+            }
+            scale = static_cast<size_t>(p - fraction);
+            if (p < end && static_cast<unsigned char>(*p - '0') < 10) {
+                return false;
+            }
+        }
+        if (val > ExactDecimal<T>::maxMantissa || scale > ExactDecimal<T>::maxScale
+            || (p < end && (*p == 'e' || *p == 'E'))) {
+            return false;
+        }
+        T value = static_cast<T>(val) / ExactDecimal<T>::pow10[scale];
+        out = negative ? -value : value;
+        return true;
+    }
+}
+
+/// <summary>
+/// parse_list ̐lŁB','̐rbg}XNŐĈxɗ̈mۂA
+/// evf͋؂TȂ1pXŕϊiȂvf Converter ɔCj
+/// </summary>
+template<typename T>
+bool parse_number_list(std::string_view str, std::vector<T>& out, std::string_view& bad)
+{
+    out.clear();
+    if (str.empty()) {
+        return true;
+    }
+    const char* p = str.data();
+    const char* end = p + str.size();
+    out.resize(count_char(p, end, ',') + (str.back() != ',' ? 1 : 0));
+
+    T* dst = out.data();
+    while (p < end) {
+        const char* token = p;
+        bool fast;
+        if constexpr (std::is_integral<T>::value || has_exact_decimal<T>::value) {
+            fast = decode_number(p, end, *dst);
+        } else {
+            fast = false;
+        }
+        // Converter Ɠľ͓ǂݎ̂Ă
+        const char* comma = p;
+        while (comma < end && *comma != ',') {
+            ++comma;
+        }
+        std::string_view element(token, static_cast<size_t>(comma - token));
+        if (!fast && !Converter<T>::parse(element, *dst)) {
+            out.resize(static_cast<size_t>(dst - out.data()));
+            bad = element;
+            return false;
+        }
+        ++dst;
+        p = comma < end ? comma + 1 : end;
+    }
+    return true;
+}
+
+/// 1s(L[, l)XpBǂ̃obt@w
+struct ConfigEntry
+{
+    std::string_view key;
+    std::string_view value;
+    size_t line = 0; // 1n܂̍sԍ
+};
+
+// =======================
+// LineScanner (sEf~^[ERg1pXŌo)
+// =======================
+class LineScanner
+{
+public:
+    /// <param name="firstLine">O܂łɓǂ񂾍sisԍ𑱂琔j</param>
+    LineScanner(std::string_view text, std::string_view delimiter, size_t firstLine = 0)
+      : pos_(text.data())
+      , end_(text.data() + text.size())
+      , line_(firstLine)
+      , delimiter_(delimiter)
+    {}
+
+    /// <summary>
+    /// ́uL[ f~^[ lvsoBsERgsEf~^[̖s͓ǂݔ΂
+    /// </summary>
+    bool next(ConfigEntry& entry)
+    {
+        while (pos_ < end_) {
+            const char* line = pos_;
+            ++line_;
+            if (*line == '\n') {
+                ++pos_;
+                continue;
+            }
+            if (*line == '#') {
+                skip_line(line);
+                continue;
+            }
+            if (delimiter_.empty()) {
+                // ̃f~^[ std::string::find ƓsɈv
+                skip_line(line);
+                entry.key = std::string_view(line, 0);
+                entry.value = std::string_view(line, static_cast<size_t>(eol_ - line));
+                entry.line = line_;
+                return true;
+            }
+
+            // sƃf~^[擪𓯎ɒT̂ŊeoCg1񂵂Ȃ
+            const char* p = line;
+            for (;;) {
+                p = find_pair(p, end_, '\n', delimiter_[0]);
+                if (p == end_ || *p == '\n') {
+                    break;
+                }
+                if (static_cast<size_t>(end_ - p) >= delimiter_.size()
+                    && std::memcmp(p, delimiter_.data(), delimiter_.size()) == 0) {
+                    const char* value = p + delimiter_.size();
+                    skip_line(value);
+                    entry.key = std::string_view(line, static_cast<size_t>(p - line));
+                    entry.value = std::string_view(value, static_cast<size_t>(eol_ - value));
+                    entry.line = line_;
+                    return true;
+                }
+                ++p;
+            }
+            pos_ = p == end_ ? end_ : p + 1;
+        }
+        return false;
+    }
+
+    /// ܂łɓǂ񂾍s
+    size_t lines() const
+    {
+        return line_;
+    }
+
+private:
+    /// from s܂ł΂Aeol_ ɍsʒuL^
+    void skip_line(const char* from)
+    {
+        eol_ = find_pair(from, end_, '\n', '\n');
+        pos_ = eol_ == end_ ? end_ : eol_ + 1;
+    }
+
+    const char* pos_;
+    const char* end_;
+    size_t line_;
+    const char* eol_ = nullptr;
+    std::string_view delimiter_;
+};
+
+// =======================
+// KeyPath (CfgɂqL[)
+// =======================
+/// <summary>
+/// l̍s߂ƂĊoA[Cfgꂽs̃L[ ".L[" ɓWJB
+/// ߂̊Oɂs̃L[͂̂܂܁i]̃tbgȏƓj
+/// </summary>
+class KeyPath
+{
+public:
+    /// WJL[ԂBʂ path_ wꍇ͎̌Ăяo܂ŗL
+    std::string_view resolve(std::string_view key, std::string_view value)
+    {
+        size_t indent = 0;
+        while (indent < key.size() && (key[indent] == ' ' || key[indent] == '\t')) {
+            ++indent;
+        }
+        while (!sections_.empty() && sections_.back().indent >= indent) {
+            sections_.pop_back();
+        }
+
+        std::string_view name = key.substr(indent);
+        std::string_view full = key;
+        if (sections_.empty()) {
+            path_.assign(name.data(), name.size());
+        } else {
+            path_.resize(sections_.back().length);
+            path_ += '.';
+            path_.append(name.data(), name.size());
+            full = path_;
+        }
+        if (skip_space(value).empty()) {
+            sections_.push_back(Section{indent, path_.size()});
+        }
+        return full;
+    }
+
+    void clear()
+    {
+        sections_.clear();
+        path_.clear();
+    }
+
+    /// O̐߂0́uL[ f~^[ lvsB
+    /// sERgsEf~^[̖s LineScanner ǂݔ΂̂Ő߂Ȃ
+    static bool top_level(std::string_view line, std::string_view delimiter)
+    {
+        if (line.empty() || line[0] == ' ' || line[0] == '\t' || line[0] == '\r'
+            || line[0] == '\n' || line[0] == '#') {
+            return false;
+        }
+        return line.substr(0, line.find('\n')).find(delimiter) != std::string_view::npos;
+    }
+
+private:
+    struct Section
+    {
+        size_t indent;
+        size_t length; // path_ ̂߂܂ł̒
+    };
+
+    std::vector<Section> sections_;
+    std::string path_;
+};
+
+// =======================
+// KeyTable (L[̃C^[)
+// =======================
+/// <summary>
+/// ẽL[1ɂێAɓ string_viewiAhXjԂB
+///  resource mۂubNɋl߂ĒuA\̔j܂œȂ
+/// </summary>
+class KeyTable
+{
+public:
+    explicit KeyTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : resource_(resource)
+      , slots_(resource)
+      , blocks_(resource)
+    {}
+
+    KeyTable(const KeyTable&) = delete;
+    KeyTable& operator=(const KeyTable&) = delete;
+
+    /// ubNƈp̂ŁAԂ͂̂܂ܗL
+    KeyTable(KeyTable&& other) noexcept
+      : resource_(other.resource_)
+      , slots_(std::move(other.slots_))
+      , blocks_(std::move(other.blocks_))
+      , mask_(std::exchange(other.mask_, 0))
+      , count_(std::exchange(other.count_, 0))
+      , head_(std::exchange(other.head_, nullptr))
+      , used_(std::exchange(other.used_, 0))
+    {
+        other.slots_.clear();
+        other.blocks_.clear();
+    }
+
+    KeyTable& operator=(KeyTable&&) = delete;
+
+    ~KeyTable()
+    {
+        for (const Block& block : blocks_) {
+            resource_->deallocate(block.data, block.size, 1);
+        }
+    }
+
+    /// key o^AێĂ镶ԂiɂΊmۂȂj
+    std::string_view intern(std::string_view key)
+    {
+        uint64_t hash = hash_key(key);
+        if (const Slot* slot = probe(hash, key)) {
+            return slot->key;
+        }
+        if ((count_ + 1) * 2 > slots_.size()) {
+            grow();
+        }
+        std::string_view stored(store(key), key.size());
+        size_t i = static_cast<size_t>(hash) & mask_;
+        while (slots_[i].key.data()) {
+            i = (i + 1) & mask_;
+        }
+        slots_[i] = Slot{hash, stored};
+        ++count_;
+        return stored;
+    }
+
+    /// o^ς݂Ȃ炻̕A data()  nullptr  view
+    std::string_view find(std::string_view key) const
+    {
+        const Slot* slot = probe(hash_key(key), key);
+        return slot ? slot->key : std::string_view();
+    }
+
+    size_t size() const
+    {
+        return count_;
+    }
+
+private:
+    struct Slot
+    {
+        uint64_t hash = 0;
+        std::string_view key; // data() == nullptr Ȃ
+    };
+
+    struct Block
+    {
+        char* data;
+        size_t size;
+    };
+
+    const Slot* probe(uint64_t hash, std::string_view key) const
+    {
+        if (slots_.empty()) {
+            return nullptr;
+        }
+        for (size_t i = static_cast<size_t>(hash) & mask_; slots_[i].key.data(); i = (i + 1) & mask_) {
+            if (slots_[i].hash == hash && slots_[i].key == key) {
+                return &slots_[i];
+            }
+        }
+        return nullptr;
+    }
+
+    void grow()
+    {
+        std::pmr::vector<Slot> old(std::max<size_t>(16, slots_.size() * 2), Slot(), slots_.get_allocator());
+        old.swap(slots_);
+        mask_ = slots_.size() - 1;
+        for (const Slot& slot : old) {
+            if (slot.key.data()) {
+                size_t i = static_cast<size_t>(slot.hash) & mask_;
+                while (slots_[i].key.data()) {
+                    i = (i + 1) & mask_;
+                }
+                slots_[i] = slot;
+            }
+        }
+    }
+
+    /// ̃L[ӂȃAhX悤A1oCgȏmۂ
+    const char* store(std::string_view key)
+    {
+        const size_t blockSize = 4096;
+        size_t need = std::max<size_t>(key.size(), 1);
+        if (need > blockSize / 4) {
+            char* data = allocate(need);
+            std::memcpy(data, key.data(), key.size());
+            return data;
+        }
+        if (!head_ || used_ + need > blockSize) {
+            head_ = allocate(blockSize);
+            used_ = 0;
+        }
+        char* data = head_ + used_;
+        std::memcpy(data, key.data(), key.size());
+        used_ += need;
+        return data;
+    }
+
+    char* allocate(size_t size)
+    {
+        char* data = static_cast<char*>(resource_->allocate(size, 1));
+        try {
+            blocks_.push_back(Block{data, size});
+        } catch (...) {
+            resource_->deallocate(data, size, 1);
+            throw;
+        }
+        return data;
+    }
+
+    std::pmr::memory_resource* resource_;
+    std::pmr::vector<Slot> slots_;
+    std::pmr::vector<Block> blocks_;
+    size_t mask_ = 0;
+    size_t count_ = 0;
+    char* head_ = nullptr;
+    size_t used_ = 0;
+};
+
+// =======================
+// FrozenTable (o^̌ptbge[u)
+// =======================
+/// string_view ňI[vAhXi`Tj\BL[͓o^̕w
+template<typename Value>
+class FrozenTable
+{
+public:
+    explicit FrozenTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+      : slots_(resource)
+    {}
+
+    /// entries  (L[, lւ̃|C^) ̕сBL[̗͐vfD悳
+    template<typename Entries>
+    void build(const Entries& entries)
+    {
+        size_t capacity = 16;
+        while (capacity < entries.size() * 2) {
+            capacity <<= 1;
+        }
+        slots_.assign(capacity, Slot());
+        mask_ = capacity - 1;
+        for (const auto& kv : entries) {
+            std::string_view key = kv.first;
+            uint64_t hash = hash_key(key);
+            size_t i = static_cast<size_t>(hash) & mask_;
+            while (slots_[i].value) {
+                i = (i + 1) & mask_;
+            }
+            slots_[i] = Slot{hash, key, kv.second};
+        }
+    }
+
+    /// <param name="stored">ꍇA\ێL[io^̕j󂯎</param>
+    Value* find(std::string_view key, std::string_view* stored = nullptr) const
+    {
+        if (slots_.empty()) {
+            return nullptr; // build OEclear 
+        }
+        uint64_t hash = hash_key(key);
+        for (size_t i = static_cast<size_t>(hash) & mask_; slots_[i].value; i = (i + 1) & mask_) {
+            if (slots_[i].hash == hash && slots_[i].key == key) {
+                if (stored) {
+                    *stored = slots_[i].key;
+                }
+                return slots_[i].value;
+            }
+        }
+        return nullptr;
+    }
+
+    bool empty() const
+    {
+        return slots_.empty();
+    }
+
+    void clear()
+    {
+        slots_.clear();
+        mask_ = 0;
+    }
+
+private:
+    struct Slot
+    {
+        uint64_t hash = 0;
+        std::string_view key;
+        Value* value = nullptr;
+    };
+
+    std::pmr::vector<Slot> slots_;
+    size_t mask_ = 0;
+};
+
+// =======================
+// s
+// =======================
+/// fn(0..count-1) ꂼʃXbhŎsi0Ԃ͌ĂяoXbhj
+template<typename Func>
+void run_parallel(size_t count, Func fn)
+{
+    std::vector<std::thread> workers;
+    workers.reserve(count > 0 ? count - 1 : 0);
+    for (size_t i = 1; i < count; ++i) {
+        workers.emplace_back(fn, i);
+    }
+    if (count > 0) {
+        fn(0);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+} // namespace config_detail
+
+// =======================
+// ff
+// =======================
+struct ParseDiagnostic
+{
+    enum class Kind
+    {
+        Key,             // o^ς݃L[o
+        UnknownKey,      // o^L[
+        ConversionError, // l̕ϊɎsitry_parse / validate ȊO͂̌Ooj
+    };
+
+    Kind kind;
+    std::string_view key;
+    std::string_view value;
+    size_t line;
+    const char* message; // ConversionError ȊO nullptr
+};
+
+using DiagnosticSink = std::function<void(const ParseDiagnostic&)>;
+
+/// ēǂݍ݂ŒlςƂɌĂ΂
+using ChangeCallback = std::function<void(std::string_view key)>;
+
+// =======================
+// OgȂ͂̌
+// =======================
+struct ParseError
+{
+    std::string key;
+    size_t line;   // 1n܂it@CJȂꍇ0j
+    size_t column; // 1n܂BslixNgȂvfj̐擪
+    std::string message;
+};
+
+enum class DumpFormat
+{
+    Text, // key<f~^[>value ̍siparse œǂݖ߂j
+    Json, // {"key": value, ...}iq "a.b" ̃L[j
+};
+
+struct ParseResult
+{
+    std::vector<ParseError> errors;
+    size_t applied = 0; // ϊɐl̐
+
+    bool ok() const
+    {
+        return errors.empty();
+    }
+};
+
+#if defined(CONFIGPARSER_STATS)
+// =======================
+// v
+// =======================
+struct ParseStats
+{
+    /// tF[YƂ̗݌vԁiimbj
+    struct Phases
+    {
+        uint64_t io = 0;       // t@C̃I[vE}bv
+        uint64_t tokenize = 0; // sEf~^[̑ip[Xł͌܂ށj
+        uint64_t lookup = 0;   // L[̓WJƌ
+        uint64_t convert = 0;  // setValue
+    };
+
+    /// IvVƂ̕ϊRXg
+    struct Cost
+    {
+        std::string_view key;
+        uint64_t calls = 0;
+        uint64_t nanos = 0;
+        uint64_t bytes = 0;       // nl̒̍v
+        uint64_t allocations = 0; // set_allocation_counter ݒ肵ꍇ̂
+    };
+
+    Phases phases;
+    std::unordered_map<const OptionBase*, Cost> options;
+
+    /// <summary>
+    /// JSON ɂBoptions ͕ϊԂ̒
+    /// </summary>
+    std::string to_json() const
+    {
+        std::vector<const Cost*> sorted;
+        sorted.reserve(options.size());
+        for (const auto& kv : options) {
+            sorted.push_back(&kv.second);
+        }
+        std::sort(sorted.begin(), sorted.end(),
+          [](const Cost* a, const Cost* b) { return a->nanos > b->nanos; });
+
+        std::string out = "{\"phases\":{\"io_ns\":" + std::to_string(phases.io)
+          + ",\"tokenize_ns\":" + std::to_string(phases.tokenize)
+          + ",\"lookup_ns\":" + std::to_string(phases.lookup)
+          + ",\"convert_ns\":" + std::to_string(phases.convert) + "},\"options\":[";
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            const Cost& cost = *sorted[i];
+            out += i ? ",{\"key\":" : "{\"key\":";
+            config_detail::append_json_string(out, cost.key);
+            out += ",\"calls\":" + std::to_string(cost.calls)
+              + ",\"convert_ns\":" + std::to_string(cost.nanos)
+              + ",\"bytes\":" + std::to_string(cost.bytes)
+              + ",\"allocations\":" + std::to_string(cost.allocations) + "}";
+        }
+        out += "]}";
+        return out;
+    }
+};
+
+/// ݌vmۉ񐔂ԂpҒ`̊֐ioperator new ̒uŐj
+using AllocationCounter = uint64_t (*)();
+
+#define CONFIGPARSER_STAT(...) __VA_ARGS__
+#else
+#define CONFIGPARSER_STAT(...)
+#endif
+
+// =======================
+// Parser {
+// =======================
+class ConfigParser 
+{
+public:
+    /// <summary>
+    /// Constructor
+    /// </summary>
+    /// <param name="delimiter">YAML̃f~^[':'ȊO\</param>
+    ConfigParser(std::string delimiter = ":")
+      : ConfigParser(std::pmr::get_default_resource(), delimiter)
+    {}
+
+    /// <summary>
+    /// IvV{́EOEl resource mۂixNg̊l͊̃q[vjB
+    /// std::pmr::monotonic_buffer_resource nΔjɂ܂Ƃ߂ĉł
+    /// </summary>
+    /// <param name="resource">p[T[蒷邱</param>
+    /// <param name="delimiter"></param>
+    explicit ConfigParser(std::pmr::memory_resource* resource, std::string delimiter = ":")
+      : resource_(resource)
+      , delimiter_(delimiter)
+      , keys_(resource)
+      , options_(resource)
+      , frozen_(resource)
+    {}
+
+    /// <summary>
+    /// o^ς݂̃IvVEL[\ETuR}hpB
+    /// ̃p[T[w lazy() ̃nh parse_async ̃Wu͎gȂȂ
+    /// </summary>
+    ConfigParser(ConfigParser&& other) noexcept
+      : resource_(other.resource_)
+      , name_(std::move(other.name_))
+      , description_(std::move(other.description_))
+      , delimiter_(std::move(other.delimiter_))
+      , partial_(std::move(other.partial_))
+      , streamLine_(other.streamLine_)
+      , diagnostics_(std::move(other.diagnostics_))
+      , keys_(std::move(other.keys_))
+      , options_(std::move(other.options_))
+      , frozen_(std::move(other.frozen_))
+      , generation_(other.generation_)
+      , keyPath_(std::move(other.keyPath_))
+      , subcommands_(std::move(other.subcommands_))
+      , factories_(std::move(other.factories_))
+      , active_subcommand_(std::exchange(other.active_subcommand_, nullptr))
+      , parent_(std::exchange(other.parent_, nullptr))
+      , watchPath_(std::move(other.watchPath_))
+      , watcher_(std::move(other.watcher_))
+      , reload_(std::move(other.reload_))
+      , pending_(std::move(other.pending_))
+      , lazy_(std::move(other.lazy_))
+      , lazyFiles_(std::move(other.lazyFiles_))
+#if defined(CONFIGPARSER_STATS)
+      , stats_(std::move(other.stats_))
+      , allocations_(other.allocations_)
+#endif
+    {
+        for (auto& kv : subcommands_) {
+            kv.second->parent_ = this;
+        }
+        other.frozen_.clear();
+    }
+
+    /// zL[\͂ꂼ memory_resource ɑ̂ŁAjĂ蒼
+    ConfigParser& operator=(ConfigParser&& other) noexcept
+    {
+        if (this != &other) {
+            ConfigParser* parent = parent_;
+            this->~ConfigParser();
+            ::new (this) ConfigParser(std::move(other));
+            parent_ = parent; // TuR}hƂĂ̈ʒu͂̂܂
+            invalidate();
+        }
+        return *this;
+    }
+
+    /// <summary>
+    /// IvVݒ
+    /// </summary>
+    /// <typeparam name="T"></typeparam>
+    /// <param name="name">L[\ɃRs[̂ŌĂяoɔjĂ悢</param>
+    /// <param name="variable">xNg̏l^ꍇ͕ŗ</param>
+    /// <param name="description"></param>
+    /// <returns></returns>
+    template<typename T>
+    Option<T>* add_option(std::string_view name, T& variable, std::string description = "")
+    {
+        return emplace_option<Option<T>>(name, variable); // `F[pɐ|C^Ԃ
+    }
+
+    template<typename T>
+    OptionFunc<T>* add_option_with_setter(
+      std::string_view name,
+      std::function<void(T)> setter,
+      std::function<T()> getter,
+      std::string description = "")
+    {
+      return emplace_option<OptionFunc<T>>(name, std::move(setter), std::move(getter));
+    }
+
+    /// _ std::function ɕ܂Ɏ󂯎iT ͖j
+    template<typename T, typename Setter, typename Getter>
+    OptionFunc<T>* add_option_with_setter(
+      std::string_view name,
+      Setter setter,
+      Getter getter,
+      std::string description = "")
+    {
+      return emplace_option<OptionFunc<T>>(name, std::move(setter), std::move(getter));
+    }
+
+    /// <summary>
+    /// default_val ŗ^lׂẴIvVɓKpiʏ parse ̑OɌĂԁj
+    /// </summary>
+    void apply_defaults()
+    {
+        options_.apply_defaults();
+    }
+
+    /// <summary>
+    /// o^ς݃IvV̌ݒlo^ɏoiTuR}h "O.L["jB
+    /// l to_chars 1̃obt@ɒڏAoȂ^ƃQb^[̖IvV͏Ȃ
+    /// </summary>
+    std::string dump(DumpFormat format = DumpFormat::Text) const
+    {
+        bool json = format == DumpFormat::Json;
+        std::string out;
+        out.reserve(dump_estimate(delimiter_.size()) + 2);
+        if (json) {
+            out += '{';
+        }
+        bool first = true;
+        dump_options(out, std::string(), delimiter_, json, first);
+        if (json) {
+            out += '}';
+        }
+        return out;
+    }
+
+    /// <summary>
+    /// ffR[obNݒ肷i͖Anullptrŉj
+    /// </summary>
+    /// <param name="sink">oL[Eo^L[EϊssԍtŎ󂯎</param>
+    void set_diagnostics(DiagnosticSink sink)
+    {
+        diagnostics_ = std::move(sink);
+    }
+
+#if defined(CONFIGPARSER_STATS)
+    /// <summary>
+    /// ܂ł̉͂̌vʁiCONFIGPARSER_STATS `̂݁j
+    /// </summary>
+    const ParseStats& stats() const
+    {
+        return stats_;
+    }
+
+    void reset_stats()
+    {
+        stats_ = ParseStats();
+    }
+
+    /// <summary>
+    /// setValue O̊mۉ񐔂𐔂֐ݒ肷inullptr ŖjBϊ͐Ȃ
+    /// </summary>
+    void set_allocation_counter(AllocationCounter counter)
+    {
+        allocations_ = counter;
+    }
+#endif
+
+    /// <summary>
+    /// o^ς݃IvVp̃tbge[uɌŒ肷B
+    /// TuR}h̃IvV "TuR}h.L[" Ƃē\ɓWJB
+    /// ANeBuȃTuR}h̃IvV͐ړȂ̃L[łig̃L[DjB
+    /// parseɂŌĂ΂Aȍ~ɃIvVǉƉ
+    /// </summary>
+    void freeze()
+    {
+        // ړo^L[ɓA̓WJL[D悳
+        std::vector<std::pair<std::string_view, OptionBase*>> entries;
+        entries.reserve(options_.size());
+        for (size_t i = 0; i < options_.size(); ++i) {
+            entries.emplace_back(options_.keys()[i], options_.options()[i]);
+        }
+        collect_paths(std::string(), entries);
+        if (active_subcommand_) {
+            const config_detail::Registry& active = active_subcommand_->options_;
+            for (size_t i = 0; i < active.size(); ++i) {
+                entries.emplace_back(active.keys()[i], active.options()[i]);
+            }
+            active_subcommand_->collect_paths(std::string(), active_subcommand_->keys_, entries);
+        }
+        frozen_.build(entries);
+    }
+
+    /// <summary>
+    /// YAML`̐ݒt@Cp[X
+    /// </summary>
+    /// <param name="configFile"></param>
+    /// <returns>0: , -1: t@CJȂ</returns>
+    int parse(const char* configFile)
+    {
+        config_detail::MappedFile file;
+        CONFIGPARSER_STAT(uint64_t start = now_ns());
+        if (!file.open(configFile)) {
+            return -1;
+        }
+        CONFIGPARSER_STAT(stats_.phases.io += now_ns() - start);
+        return parse_lines(file.view());
+    }
+
+    /// <summary>
+    /// ̐ݒeLXgp[Xit@CpXł͂Ȃj
+    /// </summary>
+    /// <param name="text"></param>
+    /// <returns>0: </returns>
+    int parse_buffer(std::string_view text)
+    {
+        return parse_lines(text);
+    }
+
+    /// <summary>
+    /// Xg[ipCvE\Pbgjǂ݂Ȃp[X
+    /// </summary>
+    /// <returns>0: , -1: ǂݍ݃G[</returns>
+    int parse(std::istream& in)
+    {
+        char chunk[64 * 1024];
+        while (in.read(chunk, sizeof(chunk)) || in.gcount() > 0) {
+            feed(std::string_view(chunk, static_cast<size_t>(in.gcount())));
+        }
+        int result = finish();
+        return in.bad() ? -1 : result;
+    }
+
+    /// <summary>
+    /// MoCgɓnBs͂̏œKpArŐ؂ꂽsێ
+    /// </summary>
+    void feed(std::string_view bytes)
+    {
+        if (!partial_.empty()) {
+            size_t eol = bytes.find('\n');
+            if (eol == std::string_view::npos) {
+                partial_.append(bytes.data(), bytes.size());
+                return;
+            }
+            partial_.append(bytes.data(), eol + 1);
+            bytes.remove_prefix(eol + 1);
+            apply_lines(partial_, streamLine_);
+            partial_.clear();
+        }
+
+        size_t last = bytes.rfind('\n');
+        if (last == std::string_view::npos) {
+            partial_.assign(bytes.data(), bytes.size());
+            return;
+        }
+        apply_lines(bytes.substr(0, last + 1), streamLine_);
+        partial_.assign(bytes.data() + last + 1, bytes.size() - last - 1);
+    }
+
+    /// <summary>
+    /// sŏIĂȂŌ̍sKpAXg[̏Ԃ
+    /// </summary>
+    /// <returns>0: </returns>
+    int finish()
+    {
+        if (!partial_.empty()) {
+            apply_lines(partial_, streamLine_);
+            partial_.clear();
+        }
+        streamLine_ = 0;
+        keyPath_.clear();
+        return 0;
+    }
+
+    /// <summary>
+    /// 傫Ȑݒt@CsEŃ`NɕAXbhŃp[XB
+    /// eL[͍Ō̏oϊ̂ŁAʂ parse Ɠ㏟B
+    /// add_option_with_setter ̃Zb^[ parse ƓoƂɃt@CŌĂ
+    /// </summary>
+    /// <param name="configFile"></param>
+    /// <param name="threads">0: n[hEFAXbh</param>
+    /// <returns>0: , -1: t@CJȂ</returns>
+    int parse_parallel(const char* configFile, unsigned threads = 0)
+    {
+        config_detail::MappedFile file;
+        CONFIGPARSER_STAT(uint64_t start = now_ns());
+        if (!file.open(configFile)) {
+            return -1;
+        }
+        CONFIGPARSER_STAT(stats_.phases.io += now_ns() - start);
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        std::string_view text = file.view();
+        // t@C̓XbhN̕
+        const size_t minChunk = 256 * 1024;
+        size_t chunks = std::min<size_t>(threads, text.size() / minChunk);
+        if (chunks <= 1) {
+            return parse_lines(text);
+        }
+        return parse_chunks(split_lines(text, chunks, delimiter_), chunks);
+    }
+
+    /// <summary>
+    /// ̐ݒt@Cd˂ēǂށi{ݒ    zXgÃt@CDjB
+    /// ǂݍ݂Ǝ͕͂ɍsA̒l̒iKŌ㏟߂̂ŁA
+    /// eIvV setValue ͍ŏIIȒlňxĂ΂B
+    ///  add_option_with_setter ̃Zb^[ׂ͂Ă̏oɂăt@CɌĂ΂
+    /// </summary>
+    /// <param name="configFiles">Dx̒Ⴂ</param>
+    /// <param name="threads">0: n[hEFAXbh</param>
+    /// <returns>0: , -1: ꂩ̃t@CJȂiKpȂj</returns>
+    int parse_layers(const std::vector<std::string>& configFiles, unsigned threads = 0)
+    {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        std::vector<config_detail::MappedFile> files(configFiles.size());
+        std::vector<char> opened(configFiles.size());
+        CONFIGPARSER_STAT(uint64_t start = now_ns());
+        size_t workers = std::min<size_t>(threads, files.size());
+        config_detail::run_parallel(workers, [&](size_t w) {
+            for (size_t i = w; i < files.size(); i += workers) {
+                opened[i] = files[i].open(configFiles[i].c_str());
+            }
+        });
+        CONFIGPARSER_STAT(stats_.phases.io += now_ns() - start);
+        if (std::find(opened.begin(), opened.end(), 0) != opened.end()) {
+            return -1;
+        }
+
+        // 傫t@C͂ɕAsԍ̓t@CƂɐ
+        std::vector<std::string_view> parts;
+        std::vector<bool> restart;
+        const size_t minChunk = 256 * 1024;
+        for (const auto& file : files) {
+            size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, file.view().size() / minChunk));
+            std::vector<std::string_view> split = split_lines(file.view(), chunks, delimiter_);
+            for (size_t k = 0; k < split.size(); ++k) {
+                parts.push_back(split[k]);
+                restart.push_back(k == 0);
+            }
+        }
+        return parse_chunks(parts, threads, restart);
+    }
+
+    /// <summary>
+    /// ϊɎsĂO𑗏oɑsAׂĂ̎ssEtŏW߂B
+    /// sl͏܂ꂸixNg͓r܂ŁjAl͒ʏǂKp
+    /// </summary>
+    ParseResult try_parse(const char* configFile)
+    {
+        return check_file(configFile, true);
+    }
+
+    /// try_parse ̃
+    ParseResult try_parse_buffer(std::string_view text)
+    {
+        return check_lines(text, true);
+    }
+
+    /// <summary>
+    /// ^ expected() ̗vfBϐɂ͈؏܂Zb^[Ă΂Ȃ
+    /// </summary>
+    ParseResult validate(const char* configFile)
+    {
+        return check_file(configFile, false);
+    }
+
+    /// validate ̃
+    ParseResult validate_buffer(std::string_view text)
+    {
+        return check_lines(text, false);
+    }
+
+    /// <summary>
+    /// parse_async ̐is󋵁Bt@C̓ǂݍ݂͕ʃXbhōsA
+    /// ́EEKp͌ĂяoiCxg[vj step ĂԂтɏi߂
+    /// </summary>
+    class AsyncParse
+    {
+    public:
+        AsyncParse(AsyncParse&&) = default;
+        AsyncParse& operator=(AsyncParse&&) = delete;
+
+        ~AsyncParse()
+        {
+            if (reader_.joinable()) {
+                reader_.join();
+            }
+        }
+
+        /// <summary>
+        /// ő lines si lines ̒ljĖ߂BǂݍݒȂ牽ɖ߂B
+        /// SľʂƍŌ step ňxɓKpA1łsΉKpȂB
+        /// step ̍ԂɃIvVTuR}ho^Ă悢iς݂̒l̓L[ňA
+        /// o^Oɓǂݔ΂s͏EȂj
+        /// </summary>
+        /// <returns>true: iresult / errors mj</returns>
+        bool step(size_t lines = 4096)
+        {
+            switch (phase_) {
+            case Phase::Reading:
+                if (source_->ready.load(std::memory_order_acquire) == 0) {
+                    return false;
+                }
+                reader_.join();
+                if (source_->ready.load(std::memory_order_relaxed) < 0) {
+                    result_ = -1;
+                    phase_ = Phase::Done;
+                    return true;
+                }
+                refresh();
+                scanner_.emplace(source_->file.view(), parser_->delimiter_);
+                phase_ = Phase::Scanning;
+                return false;
+
+            case Phase::Scanning: {
+                refresh();
+                config_detail::ConfigEntry entry;
+                for (size_t n = 0; n < lines; ++n) {
+                    if (!scanner_->next(entry)) {
+                        phase_ = Phase::Validating;
+                        break;
+                    }
+                    const char* line = entry.key.data();
+                    if (OptionBase* opt = parser_->lookup(entry, path_)) {
+                        auto found = index_.emplace(opt, hits_.size());
+                        if (found.second) {
+                            hits_.push_back(Pending{opt, entry, line});
+                        } else {
+                            hits_[found.first->second] = Pending{opt, entry, line}; // ㏟
+                        }
+                    }
+                }
+                return false;
+            }
+
+            case Phase::Validating: {
+                refresh();
+                ValueError error;
+                size_t end = std::min(hits_.size(), checked_ + lines);
+                for (; checked_ < end; ++checked_) {
+                    const Pending& hit = hits_[checked_];
+                    if (!hit.option->trySetValue(hit.entry.value, false, error)) {
+                        parser_->add_error(errors_, hit.line, hit.entry, error);
+                    }
+                }
+                if (checked_ < hits_.size()) {
+                    return false;
+                }
+                if (!errors_.ok()) {
+                    result_ = 1;
+                    phase_ = Phase::Done;
+                    return true;
+                }
+                // ς݂Ȃ̂Ŏc͏ނBňxɓKp
+                for (const Pending& hit : hits_) {
+                    parser_->apply(hit.option, hit.entry);
+                }
+                errors_.applied = hits_.size();
+                result_ = 0;
+                phase_ = Phase::Done;
+                return true;
+            }
+
+            case Phase::Done:
+                return true;
+            }
+            return true;
+        }
+
+        bool done() const
+        {
+            return phase_ == Phase::Done;
+        }
+
+        /// 0: Kpς, -1: t@CJȂ, 1: ϊłȂliKpĂȂj
+        int result() const
+        {
+            return result_;
+        }
+
+        /// ŌsisEtj
+        const ParseResult& errors() const
+        {
+            return errors_;
+        }
+
+    private:
+        friend class ConfigParser;
+
+        enum class Phase
+        {
+            Reading,
+            Scanning,
+            Validating,
+            Done,
+        };
+
+        struct Source
+        {
+            config_detail::MappedFile file;
+            std::atomic<int> ready{0}; // 0: ǂݍݒ, 1: , -1: JȂ
+        };
+
+        struct Pending
+        {
+            OptionBase* option;
+            config_detail::ConfigEntry entry;
+            const char* line;
+        };
+
+        /// <summary>
+        /// \Ă΍蒼Bo^ςĂ΁iuŌÂIvV
+        /// jĂ邱ƂjL^lێĂL[ňA蒼
+        /// </summary>
+        void refresh()
+        {
+            if (parser_->frozen_.empty()) {
+                parser_->freeze();
+            }
+            if (generation_ == parser_->generation_) {
+                return;
+            }
+            generation_ = parser_->generation_;
+            std::vector<Pending> hits;
+            index_.clear();
+            for (Pending& hit : hits_) {
+                hit.option = parser_->frozen_.find(hit.entry.key);
+                if (!hit.option) {
+                    continue;
+                }
+                auto found = index_.emplace(hit.option, hits.size());
+                if (found.second) {
+                    hits.push_back(hit);
+                } else if (hits[found.first->second].line < hit.line) {
+                    hits[found.first->second] = hit; // ㏟
+                }
+            }
+            hits_.swap(hits);
+            checked_ = 0;
+            errors_ = ParseResult();
+        }
+
+        AsyncParse(ConfigParser* parser, const char* configFile)
+          : parser_(parser)
+          , source_(std::make_unique<Source>())
+        {
+            Source* source = source_.get();
+            reader_ = std::thread([source, path = std::string(configFile)] {
+                if (!source->file.open(path.c_str())) {
+                    source->ready.store(-1, std::memory_order_release);
+                    return;
+                }
+                // step Ƀy[WtH[gŎ~܂Ȃ悤ɓǂݍł
+                std::string_view text = source->file.view();
+                volatile char sink = 0;
+                for (size_t i = 0; i < text.size(); i += 4096) {
+                    sink = sink + text[i];
+                }
+                source->ready.store(1, std::memory_order_release);
+            });
+        }
+
+        ConfigParser* parser_;
+        std::unique_ptr<Source> source_;
+        std::thread reader_;
+        Phase phase_ = Phase::Reading;
+        std::optional<config_detail::LineScanner> scanner_;
+        config_detail::KeyPath path_;
+        std::vector<Pending> hits_;
+        std::unordered_map<const OptionBase*, size_t> index_;
+        size_t checked_ = 0;
+        uint64_t generation_ = 0;
+        ParseResult errors_;
+        int result_ = 0;
+    };
+
+    /// <summary>
+    /// t@CʃXbhœǂݍݎn߁Ais󋵂Ԃip[T[͊܂Ő邱Ɓj
+    /// </summary>
+    /// <example>
+    /// auto job = parser.parse_async("app.yaml");
+    /// loop.every_tick([&amp;] { if (job.step(1000)) { /* job.result() */ } });
+    /// </example>
+    AsyncParse parse_async(const char* configFile)
+    {
+        return AsyncParse(this, configFile);
+    }
+
+    /// <summary>
+    /// lϊɊeL[̍Ō̏oʒuL^Bϊ lazy() ̃nh
+    /// ߂ēǂ񂾂Ƃi܂ materialize_alljɍsBt@C materialize_all ܂Ń}bv܂ܕێ
+    /// </summary>
+    /// <returns>0: , -1: t@CJȂ</returns>
+    int parse_lazy(const char* configFile)
+    {
+        auto file = std::make_unique<config_detail::MappedFile>();
+        CONFIGPARSER_STAT(uint64_t start = now_ns());
+        if (!file->open(configFile)) {
+            return -1;
+        }
+        CONFIGPARSER_STAT(stats_.phases.io += now_ns() - start);
+        std::string_view text = file->view();
+        if (lazy_.empty()) {
+            lazyFiles_.clear();
+        }
+        lazyFiles_.push_back(std::move(file)); // O񕪂̋L^cĂ΂̃t@Cێ
+        return parse_buffer_lazy(text);
+    }
+
+    /// <summary>
+    /// parse_lazy ̃
+    /// </summary>
+    /// <param name="text">ϊςނ܂Ő邱</param>
+    /// <returns>0: </returns>
+    int parse_buffer_lazy(std::string_view text)
+    {
+        if (frozen_.empty()) {
+            freeze();
+        }
+
+        CONFIGPARSER_STAT(ScanTimer timer(stats_));
+        config_detail::KeyPath path;
+        config_detail::LineScanner scanner(text, delimiter_);
+        config_detail::ConfigEntry entry;
+        while (scanner.next(entry)) {
+            if (OptionBase* opt = lookup(entry, path)) {
+                lazy_[opt] = entry; // ㏟
+            }
+        }
+        return 0;
+    }
+
+    /// <summary>
+    /// parse_lazy ŋL^lǂނ߂̌^tnhB
+    /// get ͋L^Έx setValue Ăϐ̒lԂB
+    /// L[o^͐VIvV
+    /// </summary>
+    template<typename T>
+    class Lazy
+    {
+    public:
+        const T& get() const
+        {
+            if (generation_ != parser_->generation_) {
+                // o^ςiL[̍ēo^Ō̃IvVjĂ邱Ƃj
+                option_ = dynamic_cast<Option<T>*>(parser_->find_option(key_));
+                if (!option_) {
+                    throw std::runtime_error("Unknown option or type mismatch: " + std::string(key_));
+                }
+                generation_ = parser_->generation_;
+            }
+            parser_->materialize(option_);
+            return option_->value();
+        }
+
+    private:
+        friend class ConfigParser;
+
+        Lazy(ConfigParser* parser, std::string_view key, Option<T>* option)
+          : parser_(parser), key_(key), option_(option), generation_(parser->generation_)
+        {}
+
+        ConfigParser* parser_;
+        std::string_view key_; // parser_ ̃L[\w
+        mutable Option<T>* option_;
+        mutable uint64_t generation_;
+    };
+
+    /// <summary>
+    /// o^ς݃IvṼnh擾
+    /// </summary>
+    /// <typeparam name="T">add_option ɓnϐ̌^</typeparam>
+    template<typename T>
+    Lazy<T> lazy(std::string_view name)
+    {
+        std::string_view key;
+        auto* opt = dynamic_cast<Option<T>*>(find_option(name, &key));
+        if (!opt) {
+            throw std::runtime_error("Unknown option or type mismatch: " + std::string(name));
+        }
+        return Lazy<T>(this, key, opt);
+    }
+
+    /// <summary>
+    /// ϊ̒lׂĕϊAێĂt@C
+    /// </summary>
+    void materialize_all()
+    {
+        while (!lazy_.empty()) {
+            materialize(lazy_.begin()->first);
+        }
+        lazyFiles_.clear();
+    }
+
+    /// <summary>
+    /// oCiLbVLȂ炻ǂݍ݁AȂeLXgp[XăLbV蒼
+    /// </summary>
+    /// <param name="configFile">̐ݒt@C</param>
+    /// <param name="cacheFile">LbVt@CioCiEo^eł̂ݗLj</param>
+    /// <returns>0: , -1: t@CJȂ</returns>
+    int parse_cached(const char* configFile, const char* cacheFile)
+    {
+        if (load_cache(configFile, cacheFile)) {
+            return 0;
+        }
+        int result = parse(configFile);
+        if (result == 0) {
+            write_cache(configFile, cacheFile);
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// configFile ɌIvV̌ݒlLbVɏoB
+    /// 񉻂łȂ^͐̒l̃eLXgAǂݍݎ setValue 
+    /// </summary>
+    bool write_cache(const char* configFile, const char* cacheFile)
+    {
+        config_detail::MappedFile source;
+        if (!source.open(configFile)) {
+            return false;
+        }
+        if (frozen_.empty()) {
+            freeze();
+        }
+
+        // L[Ƃ̍Ō̏ot@CɏW߂
+        std::vector<config_detail::ConfigEntry> entries;
+        std::unordered_map<const OptionBase*, size_t> index;
+        config_detail::KeyPath path;
+        config_detail::LineScanner scanner(source.view(), delimiter_);
+        config_detail::ConfigEntry entry;
+        while (scanner.next(entry)) {
+            const OptionBase* opt = frozen_.find(path.resolve(entry.key, entry.value), &entry.key);
+            if (!opt) {
+                continue;
+            }
+            auto it = index.find(opt);
+            if (it == index.end()) {
+                index.emplace(opt, entries.size());
+                entries.push_back(entry);
+            } else {
+                entries[it->second] = entry;
+            }
+        }
+
+        CacheHeader header = source_header(configFile, source.view());
+        header.count = static_cast<uint32_t>(entries.size());
+        std::string blob(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::string payload;
+        for (const auto& e : entries) {
+            payload.clear();
+            uint8_t kind = find_option(e.key)->save(payload) ? CacheBinary : CacheText;
+            if (kind == CacheText) {
+                payload.assign(e.value.data(), e.value.size());
+            }
+            config_detail::put_raw(blob, static_cast<uint32_t>(e.key.size()));
+            config_detail::put_raw(blob, static_cast<uint32_t>(payload.size()));
+            config_detail::put_raw(blob, kind);
+            blob.append(e.key.data(), e.key.size());
+            blob.append(payload);
+        }
+        config_detail::put_raw(blob, config_detail::hash_key(blob));
+
+        // ǂ܂Ȃ悤ꎞt@Cu
+        std::string temp = std::string(cacheFile) + ".tmp";
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out.write(blob.data(), static_cast<std::streamsize>(blob.size()))) {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(temp, cacheFile, ec);
+        return !ec;
+    }
+
+    /// <summary>
+    /// LbV؂ēKpBt@C̍XVςĂΓẽnbVŔ肷
+    /// </summary>
+    /// <returns>false: LbVEĂEÂ</returns>
+    bool load_cache(const char* configFile, const char* cacheFile)
+    {
+        config_detail::MappedFile cache;
+        if (!cache.open(cacheFile)) {
+            return false;
+        }
+        std::string_view blob = cache.view();
+        CacheHeader header;
+        uint64_t checksum;
+        if (blob.size() < sizeof(header) + sizeof(checksum)) {
+            return false;
+        }
+        std::memcpy(&header, blob.data(), sizeof(header));
+        std::memcpy(&checksum, blob.data() + blob.size() - sizeof(checksum), sizeof(checksum));
+        std::string_view body = blob.substr(0, blob.size() - sizeof(checksum));
+        if (std::memcmp(header.magic, CacheMagic, sizeof(header.magic)) != 0
+            || header.version != CacheVersion || config_detail::hash_key(body) != checksum) {
+            return false;
+        }
+
+        std::error_code ec;
+        auto size = std::filesystem::file_size(configFile, ec);
+        if (ec || size != header.sourceSize) {
+            return false;
+        }
+        if (mtime(configFile) != header.sourceTime) {
+            config_detail::MappedFile source;
+            if (!source.open(configFile)
+                || config_detail::hash_key(source.view()) != header.sourceHash) {
+                return false;
+            }
+        }
+
+        if (frozen_.empty()) {
+            freeze();
+        }
+        std::string_view data = body.substr(sizeof(header));
+        for (uint32_t i = 0; i < header.count; ++i) {
+            uint32_t keyLen, payloadLen;
+            uint8_t kind;
+            if (!config_detail::get_raw(data, keyLen) || !config_detail::get_raw(data, payloadLen)
+                || !config_detail::get_raw(data, kind) || data.size() < size_t(keyLen) + payloadLen) {
+                return false;
+            }
+            std::string_view key = data.substr(0, keyLen);
+            std::string_view payload = data.substr(keyLen, payloadLen);
+            data.remove_prefix(size_t(keyLen) + payloadLen);
+
+            OptionBase* opt = find_option(key);
+            if (!opt) {
+                return false; // o^eς
+            }
+            if (kind == CacheText) {
+                opt->setValue(payload);
+            } else if (!opt->load(payload)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// ݒt@Cǂݍ݁AύXĎJn
+    /// </summary>
+    /// <param name="configFile"></param>
+    /// <returns>KpL[, -1: t@CJȂ</returns>
+    int watch(const char* configFile)
+    {
+        watchPath_ = configFile;
+        watcher_.watch(configFile);
+        return reload();
+    }
+
+    /// <summary>
+    /// Ď̃t@CύXĂ΍ēǂݍ݂iubNȂj
+    /// </summary>
+    /// <returns>lςL[, -1: t@CJȂ</returns>
+    int poll_reload()
+    {
+        if (watchPath_.empty() || !watcher_.changed()) {
+            return 0;
+        }
+        return reload();
+    }
+
+    /// <summary>
+    /// Ď̃t@CǂݒAOƐ̒lقȂL[ setValue B
+    /// t@CL[͑O̒l̂܂
+    /// </summary>
+    /// <returns>lςL[, -1: t@CJȂ</returns>
+    int reload()
+    {
+        config_detail::MappedFile file;
+        CONFIGPARSER_STAT(uint64_t start = now_ns());
+        if (watchPath_.empty() || !file.open(watchPath_.c_str())) {
+            return -1;
+        }
+        CONFIGPARSER_STAT(stats_.phases.io += now_ns() - start);
+        return reload_lines(file.view());
+    }
+
+    /// <summary>
+    /// ēǂݍ݂ŒlςƂ̃R[obNo^
+    /// </summary>
+    /// <param name="name">o^ς݂̃IvV</param>
+    /// <param name="callback"></param>
+    void on_change(std::string_view name, ChangeCallback callback)
+    {
+        OptionBase* opt = find_option(name);
+        if (!opt) {
+            throw std::runtime_error("Unknown option: " + std::string(name));
+        }
+        reload_[opt].onChange = std::move(callback);
+    }
+
+    /// <summary>
+    /// ^t̒leLXgɐݒ肷Bϐ̌^ add_option ɓn̂ƈv邱ƁB
+    /// 񃊃e std::string_view ̓eLXgƂ setValue istd::string ͑j
+    /// </summary>
+    /// <returns>false: o^̃L[</returns>
+    template<typename T>
+    bool set_value(std::string_view name, const T& value)
+    {
+        OptionBase* opt = find_option(name);
+        if (!opt) {
+            return false;
+        }
+        if constexpr (config_detail::is_text<T>::value && !std::is_same<T, std::string>::value) {
+            discard_lazy(opt);
+            opt->setValue(std::string_view(value));
+        } else {
+            assign_typed(opt, name, value);
+        }
+        return true;
+    }
+
+    /// <summary>
+    /// (L[, l) ̕т܂Ƃ߂Đݒ肷Bl̈ set_value Ɠ
+    /// istd::string_view / const char*  setValue ŕϊAȊO͒ڑjBvfƂ̊mۂ͖
+    /// </summary>
+    /// <param name="items">first L[Asecond l̗vf͈́ipair  vector zj</param>
+    /// <returns>Kpio^L[͓ǂݔ΂j</returns>
+    template<typename Range>
+    size_t set_all(const Range& items)
+    {
+        size_t applied = 0;
+        for (const auto& item : items) {
+            using Value = typename std::decay<decltype(item.second)>::type;
+            OptionBase* opt = find_option(item.first);
+            if (!opt) {
+                continue;
+            }
+            if constexpr (config_detail::is_text<Value>::value && !std::is_same<Value, std::string>::value) {
+                discard_lazy(opt);
+                opt->setValue(std::string_view(item.second));
+            } else {
+                assign_typed(opt, item.first, item.second);
+            }
+            ++applied;
+        }
+        return applied;
+    }
+
+    // TuR}h
+    ConfigParser* add_subcommand(
+      const std::string& name, const std::string& description = "")
+    {
+      auto found = subcommands_.find(name);
+      if (found != subcommands_.end()) {
+        return found->second.get(); // o^ς݂Ȃ蒼ȂiANeBuȂ̂w邽߁j
+      }
+      auto sub = std::make_unique<ConfigParser>(resource_);
+      sub->name_ = name;
+      sub->description_ = description;
+      sub->parent_ = this;
+      auto ptr = sub.get();
+      subcommands_[name] = std::move(sub);
+      factories_.erase(name);
+      invalidate();
+      return ptr;
+    }
+
+    using SubcommandFactory = std::function<void(ConfigParser&)>;
+
+    /// <summary>
+    /// TuR}hxo^Bparse_subcommand ŏ߂ăANeBuƂA܂
+    /// on_changeEset_valueElazy  "TuR}h.L[" w肵ƂɃp[T[\zA
+    /// factory ŃIvVo^iparse ͍\zÕTuR}h̃L[𖢓o^ƂĈj
+    /// </summary>
+    /// <param name="name"></param>
+    /// <param name="factory">\zTuR}h̃p[T[󂯎 add_option Ă</param>
+    /// <param name="description"></param>
+    void add_subcommand(
+      const std::string& name, SubcommandFactory factory, const std::string& description = "")
+    {
+      if (subcommands_.count(name)) {
+        return; // \zς݂̓TuR}hD悷
+      }
+      factories_[name] = PendingSubcommand{std::move(factory), description};
+    }
+
+    /// <summary>
+    /// TuR}hANeBuBȍ~ parse ł͎gɖL[
+    /// ANeBuȃTuR}h̃IvVƂĈ
+    /// </summary>
+    /// <param name="name"></param>
+    /// <returns>ANeBuTuR}h̃p[T[</returns>
+    ConfigParser* parse_subcommand(const std::string& name)
+    {
+      ConfigParser* sub = build_subcommand(name);
+      if (!sub) {
+        throw std::runtime_error("Unknown subcommand: " + name);
+      }
+      active_subcommand_ = sub;
+      invalidate();
+      return sub;
+    }
+
+  protected:
+    void set(std::string_view name, std::string_view value)
+    {
+        if (OptionBase* opt = find_option(name)) {
+            discard_lazy(opt);
+            opt->setValue(value);
+        }
+    }
+
+private:
+    /// IvV resource_ ɍ\zēo^
+    template<typename Opt, typename... Args>
+    Opt* emplace_option(std::string_view name, Args&&... args)
+    {
+        // O̓L[\1ɒuAIvVƃWXg͂w
+        std::string_view key = keys_.intern(name);
+        void* block = resource_->allocate(sizeof(Opt), alignof(Opt));
+        Opt* opt;
+        try {
+            opt = ::new (block) Opt(key, std::forward<Args>(args)..., resource_);
+        } catch (...) {
+            resource_->deallocate(block, sizeof(Opt), alignof(Opt));
+            throw;
+        }
+        config_detail::OptionPtr ptr(opt, config_detail::OptionDeleter{resource_, block, sizeof(Opt), alignof(Opt)});
+        config_detail::OptionPtr old = options_.add(key, std::move(ptr));
+        if (old) {
+            replace_option(old.get(), opt);
+        }
+        invalidate();
+        return opt; // old ͂Ŕj
+    }
+
+    /// <summary>
+    /// uŔjIvVwL^VIvVɕtւiTuR}h͐̕ejB
+    /// ϊ̒l͂̂܂ܐVIvVɓnAēǂݍ݂̑Ol͖YĎ reload ŕKKp
+    /// </summary>
+    void replace_option(OptionBase* from, OptionBase* to)
+    {
+        for (ConfigParser* p = this; p; p = p->parent_) {
+            // m[htւ̂ pending_ w ReloadSlot Ȃ
+            auto lazy = p->lazy_.extract(from);
+            if (!lazy.empty()) {
+                lazy.key() = to;
+                p->lazy_.insert(std::move(lazy));
+            }
+            auto reload = p->reload_.extract(from);
+            if (!reload.empty()) {
+                reload.key() = to;
+                reload.mapped().option = to;
+                reload.mapped().known = false;
+                p->reload_.insert(std::move(reload));
+            }
+#if defined(CONFIGPARSER_STATS)
+            p->stats_.options.erase(from);
+#endif
+        }
+    }
+
+    /// <summary>
+    /// obt@𑖍GW(L[, l)XpɕēKpiln܂ōsƂ̊mۂȂj
+    /// </summary>
+    int parse_lines(std::string_view text)
+    {
+        size_t line = 0;
+        keyPath_.clear();
+        apply_lines(text, line);
+        keyPath_.clear();
+        return 0;
+    }
+
+    /// line ͓ǂ񂾍si߂Bq̐߂ keyPath_ Ɏĉ feed ܂ő
+    void apply_lines(std::string_view text, size_t& line)
+    {
+        if (frozen_.empty()) {
+            freeze();
+        }
+
+        CONFIGPARSER_STAT(ScanTimer timer(stats_));
+        config_detail::LineScanner scanner(text, delimiter_, line);
+        config_detail::ConfigEntry entry;
+        while (scanner.next(entry)) {
+            if (OptionBase* opt = lookup(entry, keyPath_)) {
+                apply(opt, entry);
+            }
+        }
+        line = scanner.lines();
+    }
+
+    /// <summary>
+    /// eL[̍Ō̏oO̐̒lƔrAς̂Kp
+    /// </summary>
+    int reload_lines(std::string_view text)
+    {
+        if (frozen_.empty()) {
+            freeze();
+        }
+
+        pending_.clear();
+        CONFIGPARSER_STAT(ScanTimer timer(stats_));
+        config_detail::KeyPath path;
+        config_detail::LineScanner scanner(text, delimiter_);
+        config_detail::ConfigEntry entry;
+        while (scanner.next(entry)) {
+            if (OptionBase* opt = lookup(entry, path)) {
+                ReloadSlot& slot = reload_[opt];
+                slot.option = opt;
+                slot.last = pending_.size();
+                pending_.emplace_back(&slot, entry);
+            }
+        }
+
+        int changed = 0;
+        for (size_t i = 0; i < pending_.size(); ++i) {
+            ReloadSlot& slot = *pending_[i].first;
+            const config_detail::ConfigEntry& e = pending_[i].second;
+            if (slot.last != i || (slot.known && slot.raw == e.value)) {
+                continue;
+            }
+            apply(slot.option, e);
+            slot.raw.assign(e.value.data(), e.value.size());
+            slot.known = true;
+            ++changed;
+            if (slot.onChange) {
+                slot.onChange(e.key);
+            }
+        }
+        pending_.clear();
+        return changed;
+    }
+
+    ParseResult check_file(const char* configFile, bool commit)
+    {
+        config_detail::MappedFile file;
+        CONFIGPARSER_STAT(uint64_t start = now_ns());
+        if (!file.open(configFile)) {
+            ParseResult result;
+            result.errors.push_back(ParseError{std::string(), 0, 0, "Cannot open file: " + std::string(configFile)});
+            return result;
+        }
+        CONFIGPARSER_STAT(stats_.phases.io += now_ns() - start);
+        return check_lines(file.view(), commit);
+    }
+
+    /// apply_lines ̗OgȂ
+    ParseResult check_lines(std::string_view text, bool commit)
+    {
+        if (frozen_.empty()) {
+            freeze();
+        }
+
+        ParseResult result;
+        CONFIGPARSER_STAT(ScanTimer timer(stats_));
+        config_detail::KeyPath path;
+        config_detail::LineScanner scanner(text, delimiter_);
+        config_detail::ConfigEntry entry;
+        ValueError error;
+        while (scanner.next(entry)) {
+            const char* line = entry.key.data();
+            OptionBase* opt = lookup(entry, path);
+            if (!opt) {
+                continue;
+            }
+            if (commit) {
+                discard_lazy(opt);
+            }
+            bool ok;
+            {
+                CONFIGPARSER_STAT(ConvertTimer convert(*this, opt, entry));
+                ok = opt->trySetValue(entry.value, commit, error);
+            }
+            if (ok) {
+                ++result.applied;
+                continue;
+            }
+            add_error(result, line, entry, error);
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// s result ɉĐffB͒l̑Ő󔒂ʒuw
+    /// </summary>
+    /// <param name="line">entry ̍s̐擪</param>
+    void add_error(ParseResult& result, const char* line, const config_detail::ConfigEntry& entry, ValueError& error)
+    {
+        const char* at = error.at.data() ? error.at.data() : entry.value.data();
+        const char* end = entry.value.data() + entry.value.size();
+        while (at < end && (*at == ' ' || *at == '\t')) {
+            ++at;
+        }
+        result.errors.push_back(ParseError{
+          std::string(entry.key), entry.line, static_cast<size_t>(at - line) + 1, std::move(error.message)});
+        if (diagnostics_) {
+            report(ParseDiagnostic::Kind::ConversionError, entry, result.errors.back().message.c_str());
+        }
+        error = ValueError();
+    }
+
+    struct Hit
+    {
+        OptionBase* option;
+        config_detail::ConfigEntry entry;
+    };
+
+    /// text 悻 count AeЂCfg̖L[̍s̐擪n܂悤ɋ؂
+    static std::vector<std::string_view> split_lines(
+      std::string_view text, size_t count, std::string_view delimiter)
+    {
+        std::vector<std::string_view> parts;
+        size_t begin = 0;
+        for (size_t i = 1; i <= count && begin < text.size(); ++i) {
+            size_t end = i == count ? text.size() : std::max(begin, text.size() / count * i);
+            while (end < text.size()) {
+                end = text.find('\n', end);
+                end = end == std::string_view::npos ? text.size() : end + 1;
+                // ߂̓rŐ؂Ɠq̃L[WJłȂ
+                if (config_detail::KeyPath::top_level(text.substr(end), delimiter)) {
+                    break;
+                }
+            }
+            parts.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+        return parts;
+    }
+
+    /// <summary>
+    /// ͂ƌ̓`NƂɕA҂̌̓t@CAϊ͍Ăѕōs
+    /// </summary>
+    /// <param name="restart">vf true ̃`Nsԍ1ɖ߂iȂʂԍj</param>
+    int parse_chunks(const std::vector<std::string_view>& parts, size_t threads,
+      const std::vector<bool>& restart = {})
+    {
+        if (frozen_.empty()) {
+            freeze();
+        }
+
+        std::vector<std::vector<Hit>> hits(parts.size());
+        std::vector<size_t> lines(parts.size());
+        // o^̓qL[͐ff܂œWJ̕cĂ
+        std::vector<std::list<std::string>> unknown(parts.size());
+        size_t scanners = std::min(threads, parts.size());
+        CONFIGPARSER_STAT(uint64_t start = now_ns());
+        config_detail::run_parallel(scanners, [&](size_t w) {
+            for (size_t i = w; i < parts.size(); i += scanners) {
+                config_detail::KeyPath path;
+                config_detail::LineScanner scanner(parts[i], delimiter_);
+                config_detail::ConfigEntry entry;
+                while (scanner.next(entry)) {
+                    std::string_view key = path.resolve(entry.key, entry.value);
+                    OptionBase* opt = frozen_.find(key, &entry.key);
+                    if (!opt && diagnostics_ && key.data() != entry.key.data()) {
+                        entry.key = unknown[i].emplace_back(key);
+                    }
+                    if (opt || diagnostics_) {
+                        hits[i].push_back(Hit{opt, entry});
+                    }
+                }
+                lines[i] = scanner.lines();
+            }
+        });
+        CONFIGPARSER_STAT(stats_.phases.tokenize += now_ns() - start);
+
+        // t@CɐffoA납猩ĊeIvV̍Ō̏oIԁB
+        // ĂяoXbhœKpZb^[ parse ƓSoɓn
+        size_t base = 0;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            if (i < restart.size() && restart[i]) {
+                base = 0;
+            }
+            for (Hit& hit : hits[i]) {
+                hit.entry.line += base;
+                if (diagnostics_) {
+                    report(hit.option ? ParseDiagnostic::Kind::Key : ParseDiagnostic::Kind::UnknownKey,
+                      hit.entry, nullptr);
+                }
+            }
+            base += lines[i];
+        }
+        std::vector<const Hit*> winners;
+        std::vector<const Hit*> serial;
+        std::unordered_set<const OptionBase*> seen;
+        for (size_t i = parts.size(); i-- > 0;) {
+            for (size_t j = hits[i].size(); j-- > 0;) {
+                const Hit& hit = hits[i][j];
+                if (!hit.option) {
+                    continue;
+                }
+                if (!hit.option->parallelSafe()) {
+                    serial.push_back(&hit);
+                } else if (seen.insert(hit.option).second) {
+                    winners.push_back(&hit);
+                }
+            }
+        }
+        std::reverse(winners.begin(), winners.end());
+        std::reverse(serial.begin(), serial.end());
 
-    Option<T>* expected(size_t n)
-    {
-        expectedCount_ = n;
-        return this;
+        for (const Hit* hit : winners) {
+            discard_lazy(hit->option);
+        }
+
+        // ϊ̗O̓t@CōłÔ̂𑗏o
+        std::vector<std::exception_ptr> errors(winners.size());
+        size_t workers = std::min(threads, winners.size());
+        CONFIGPARSER_STAT(std::vector<uint64_t> nanos(winners.size()); start = now_ns());
+        config_detail::run_parallel(workers, [&](size_t w) {
+            for (size_t i = w; i < winners.size(); i += workers) {
+                CONFIGPARSER_STAT(uint64_t begin = now_ns());
+                try {
+                    winners[i]->option->setValue(winners[i]->entry.value);
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+                CONFIGPARSER_STAT(nanos[i] = now_ns() - begin);
+            }
+        });
+        CONFIGPARSER_STAT(
+          stats_.phases.convert += now_ns() - start;
+          for (size_t i = 0; i < winners.size(); ++i) {
+              record(winners[i]->option, winners[i]->entry, nanos[i], 0);
+          })
+        for (size_t i = 0; i < winners.size(); ++i) {
+            if (errors[i]) {
+                rethrow_reported(errors[i], winners[i]->entry);
+            }
+        }
+        for (const Hit* hit : serial) {
+            apply(hit->option, hit->entry);
+        }
+        return 0;
     }
 
-    void applyDefault() override
+    [[noreturn]] void rethrow_reported(std::exception_ptr error, const config_detail::ConfigEntry& entry)
     {
-        if (!defaultVal_.empty())
-            setValue(defaultVal_);
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& e) {
+            if (diagnostics_) {
+                report(ParseDiagnostic::Kind::ConversionError, entry, e.what());
+            }
+            throw;
+        }
     }
 
-    void setValue(const std::string& str) override
+    /// <summary>
+    /// entry.key q̃pXɓWJČB entry.key ͓o^w悤ɂȂ
+    /// </summary>
+    OptionBase* lookup(config_detail::ConfigEntry& entry, config_detail::KeyPath& path)
     {
-        std::istringstream iss(str);
-        T val;
-        iss >> val;
-        if (!iss.fail()) {
-            ref_ = val;
-        } else {
-            throw std::runtime_error("Failed to parse value: " + str);
+        CONFIGPARSER_STAT(uint64_t start = now_ns());
+        std::string_view key = path.resolve(entry.key, entry.value);
+        OptionBase* opt = frozen_.find(key, &entry.key);
+        if (!opt) {
+            entry.key = key;
+        }
+        CONFIGPARSER_STAT(stats_.phases.lookup += now_ns() - start);
+        if (diagnostics_) {
+            report(opt ? ParseDiagnostic::Kind::Key : ParseDiagnostic::Kind::UnknownKey,
+              entry, nullptr);
         }
+        return opt;
     }
 
-private:
-    T& ref_;
-    std::string name_;
-    std::string defaultVal_;
-    size_t expectedCount_ = 0;
-};
-
-template<typename T>
-class Option<std::vector<T>, void> : public OptionBase 
-{
-public:
-    Option(const std::string& name, std::vector<T>& ref): name_(name), ref_(ref)
-    {}
-
-    template<typename U>
-    Option<std::vector<T>>* default_val(const U& val)
+    void apply(OptionBase* opt, const config_detail::ConfigEntry& entry)
     {
-        std::ostringstream oss;
-        oss << val;
-        defaultVal_ = oss.str();
-        return this;
+        discard_lazy(opt);
+        CONFIGPARSER_STAT(ConvertTimer timer(*this, opt, entry));
+        try {
+            opt->setValue(entry.value);
+        } catch (const std::exception& e) {
+            if (diagnostics_) {
+                report(ParseDiagnostic::Kind::ConversionError, entry, e.what());
+            }
+            throw;
+        }
     }
 
-    Option<std::vector<T>>* expected(size_t n)
+#if defined(CONFIGPARSER_STATS)
+    static uint64_t now_ns()
     {
-        expectedCount_ = n;
-        return this;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count());
     }
 
-    void applyDefault() override
+    void record(const OptionBase* opt, const config_detail::ConfigEntry& entry,
+      uint64_t nanos, uint64_t allocations)
     {
-        if (!defaultVal_.empty())
-            setValue(defaultVal_);
+        ParseStats::Cost& cost = stats_.options[opt];
+        cost.key = entry.key; // o^iL[\jw
+        ++cost.calls;
+        cost.nanos += nanos;
+        cost.bytes += entry.value.size();
+        cost.allocations += allocations;
     }
 
-    void setValue(const std::string& str) override
+    /// Ŝ̎Ԃ猟ƕϊ̕Ď͂̎ԂƂ
+    struct ScanTimer
     {
-        ref_.clear();
-        std::istringstream iss(str);
-        std::string token;
+        explicit ScanTimer(ParseStats& stats)
+          : stats_(stats)
+          , start_(now_ns())
+          , lookup_(stats.phases.lookup)
+          , convert_(stats.phases.convert)
+        {}
 
-        while (std::getline(iss, token, ',')) {
-            std::istringstream elem_iss(token);
-            T val;
-            elem_iss >> val;
-            if (elem_iss) {
-            ref_.push_back(val);
-            } else {
-            throw std::runtime_error("Parse error in vector element: " + token);
-            }
+        ~ScanTimer()
+        {
+            uint64_t inner = (stats_.phases.lookup - lookup_) + (stats_.phases.convert - convert_);
+            stats_.phases.tokenize += now_ns() - start_ - inner;
         }
 
-        if (expectedCount_ > 0 && ref_.size() != expectedCount_) {
-            throw std::runtime_error(
-            "Expected " + std::to_string(expectedCount_) + " elements, got "
-            + std::to_string(ref_.size()));
+        ParseStats& stats_;
+        uint64_t start_;
+        uint64_t lookup_;
+        uint64_t convert_;
+    };
+
+    /// 1 setValue ̎ԂƊmۉ񐔂L^iOŔĂL^j
+    struct ConvertTimer
+    {
+        ConvertTimer(ConfigParser& parser, const OptionBase* opt, const config_detail::ConfigEntry& entry)
+          : parser_(parser)
+          , opt_(opt)
+          , entry_(entry)
+          , allocations_(parser.allocations_ ? parser.allocations_() : 0)
+          , start_(now_ns())
+        {}
+
+        ~ConvertTimer()
+        {
+            uint64_t nanos = now_ns() - start_;
+            uint64_t allocations = parser_.allocations_ ? parser_.allocations_() - allocations_ : 0;
+            parser_.stats_.phases.convert += nanos;
+            parser_.record(opt_, entry_, nanos, allocations);
         }
-    }
 
-private:
-    std::vector<T>& ref_;
-    std::string name_;
-    std::string defaultVal_;
-    size_t expectedCount_ = 0;
-};
+        ConfigParser& parser_;
+        const OptionBase* opt_;
+        const config_detail::ConfigEntry& entry_;
+        uint64_t allocations_;
+        uint64_t start_;
+    };
+#endif
 
-template<typename T>
-class Option<T, typename std::enable_if<std::is_enum<T>::value>::type>
-  : public OptionBase 
-{
-public:
-    Option(const std::string& name, T& ref): name_(name), ref_(ref)
-    {}
+    template<typename T>
+    void assign_typed(OptionBase* opt, std::string_view name, const T& value)
+    {
+        discard_lazy(opt);
+        if (auto* typed = dynamic_cast<Option<T>*>(opt)) {
+            typed->assign(value);
+        } else if (auto* func = dynamic_cast<OptionFunc<T>*>(opt)) {
+            func->assign(value);
+        } else {
+            throw std::runtime_error("Type mismatch for option: " + std::string(name));
+        }
+    }
 
-    template<typename U>
-    Option<T>* default_val(const U& val)
+    /// L^ΎoĕϊBO apply ƓffĂ瑗o
+    void materialize(OptionBase* opt)
     {
-        std::ostringstream oss;
-        oss << static_cast<typename std::underlying_type<T>::type>(val);
-        defaultVal_ = oss.str();
-        return this;
+        if (lazy_.empty()) {
+            return;
+        }
+        auto it = lazy_.find(opt);
+        if (it != lazy_.end()) {
+            config_detail::ConfigEntry entry = it->second;
+            lazy_.erase(it);
+            apply(opt, entry);
+        }
     }
 
-    Option<T>* expected(size_t n)
+    /// ォ疾IɒlIvV̌ÂL^̂Ă
+    void discard_lazy(OptionBase* opt)
     {
-        expectedCount_ = n;
-        return this;
+        if (!lazy_.empty()) {
+            lazy_.erase(opt);
+        }
     }
 
-    void applyDefault() override
+    void report(
+      ParseDiagnostic::Kind kind, const config_detail::ConfigEntry& entry, const char* message)
     {
-        if (!defaultVal_.empty())
-            setValue(defaultVal_);
+        diagnostics_(ParseDiagnostic{kind, entry.key, entry.value, entry.line, message});
     }
 
-    void setValue(const std::string& str) override
+    /// <summary>
+    /// parse Ɠ\ňiq ".L[" ANeBuȃTuR}h̃L[Ăяoɂ炸jB
+    /// "TuR}h.L[" xo^̃TuR}hwĂ΍\zĂ
+    /// </summary>
+    /// <param name="stored">΂̕\ɓo^ꂽOiL[\wj</param>
+    OptionBase* find_option(std::string_view name, std::string_view* stored = nullptr)
     {
-        // lenumϊi񂩂g\j
-        std::istringstream iss(str);
-        typename std::underlying_type<T>::type val;
-        iss >> val;
-        if (!iss.fail()) {
-            ref_ = static_cast<T>(val);
-        } else {
-            throw std::runtime_error("Failed to parse enum value: " + str);
+        if (frozen_.empty()) {
+            freeze();
+        }
+        if (OptionBase* opt = frozen_.find(name, stored)) {
+            return opt;
         }
+        size_t dot = name.find('.');
+        if (dot == std::string_view::npos || (factories_.empty() && subcommands_.empty())) {
+            return nullptr;
+        }
+        ConfigParser* sub = build_subcommand(std::string(name.substr(0, dot)));
+        if (!sub || !sub->find_option(name.substr(dot + 1))) {
+            return nullptr;
+        }
+        // \zŕ\Ă̂ŁA蒼Ă̕\̖Oň
+        if (frozen_.empty()) {
+            freeze();
+        }
+        return frozen_.find(name, stored);
     }
 
-private:
-    T& ref_;
-    std::string name_;
-    std::string defaultVal_;
-    size_t expectedCount_ = 0;
-};
+    /// \zς݂̃TuR}hBxo^Ȃ\z factory ĂԁB nullptr
+    ConfigParser* build_subcommand(const std::string& name)
+    {
+      auto it = subcommands_.find(name);
+      if (it != subcommands_.end()) {
+        return it->second.get();
+      }
+      auto factory = factories_.find(name);
+      if (factory == factories_.end()) {
+        return nullptr;
+      }
+      PendingSubcommand pending = std::move(factory->second);
+      ConfigParser* sub = add_subcommand(name, pending.description); // factories_ O
+      if (pending.factory) {
+        pending.factory(*sub);
+      }
+      return sub;
+    }
 
-template<typename T>
-class OptionFunc : public OptionBase {
-public:
-  OptionFunc(
-    const std::string& name,
-    std::function<void(T)> setter,
-    std::function<T()> getter)
-    : name_(name)
-    , setter_(setter)
-    , getter_(getter)
-  {}
+    /// dump ̏o͒̌ςiL[̍v + lƂɈʁj
+    size_t dump_estimate(size_t delimiter) const
+    {
+        const size_t valueEstimate = 24;
+        size_t size = 0;
+        for (std::string_view key : options_.keys()) {
+            size += key.size() + delimiter + valueEstimate;
+        }
+        for (const auto& kv : subcommands_) {
+            size += kv.second->dump_estimate(delimiter + kv.first.size() + 1);
+        }
+        return size;
+    }
 
-  OptionFunc* default_val(const std::string& val)
-  {
-    defaultVal_ = val;
-    return this;
-  }
+    void dump_options(std::string& out, const std::string& prefix, std::string_view delimiter,
+      bool json, bool& first) const
+    {
+        for (size_t i = 0; i < options_.size(); ++i) {
+            size_t mark = out.size();
+            std::string_view key = options_.keys()[i];
+            if (json) {
+                if (!first) {
+                    out += ',';
+                }
+                std::string path = prefix;
+                config_detail::append_json_string(out, prefix.empty() ? key : std::string_view(path.append(key)));
+                out += ':';
+            } else {
+                out += prefix;
+                out += key;
+                out += delimiter;
+            }
+            if (!options_.write(i, out, json)) {
+                out.resize(mark);
+                continue;
+            }
+            if (!json) {
+                out += '\n';
+            }
+            first = false;
+        }
+        for (const auto& kv : subcommands_) {
+            kv.second->dump_options(out, prefix + kv.first + '.', delimiter, json, first);
+        }
+    }
 
-  OptionFunc* description(const std::string& desc)
-  {
-    description_ = desc;
-    return this;
-  }
+    /// gƐẽtbge[uie͓WJL[߁j
+    void invalidate()
+    {
+        for (ConfigParser* p = this; p; p = p->parent_) {
+            p->frozen_.clear();
+            ++p->generation_;
+        }
+    }
 
-  void setValue(const std::string& str) override
-  {
-    std::istringstream iss(str);
-    T temp;
-    iss >> temp;
-    setter_(temp);
-  }
+    /// TuR}h̃IvV "prefixTuR}h.L[" ƂăL[\ɓo^ entries ɉiċAj
+    void collect_paths(const std::string& prefix, std::vector<std::pair<std::string_view, OptionBase*>>& entries)
+    {
+        collect_paths(prefix, keys_, entries);
+    }
 
-  void applyDefault()
-  {
-    if (!defaultVal_.empty()) {
-      setValue(defaultVal_);
+    void collect_paths(const std::string& prefix, config_detail::KeyTable& keys,
+      std::vector<std::pair<std::string_view, OptionBase*>>& entries) const
+    {
+        std::string path;
+        for (const auto& kv : subcommands_) {
+            std::string sub = prefix + kv.first + '.';
+            const config_detail::Registry& options = kv.second->options_;
+            for (size_t i = 0; i < options.size(); ++i) {
+                path.assign(sub).append(options.keys()[i]);
+                entries.emplace_back(keys.intern(path), options.options()[i]);
+            }
+            kv.second->collect_paths(sub, keys, entries);
+        }
     }
-  }
-  OptionFunc* transform(std::function<T(const std::string&)> conv)
-  {
-    transformer_ = conv;
-    return this;
-  }
 
-  void setValue(const std::string& str) override
-  {
-    std::string lowerStr = str;
-    std::transform(
-      lowerStr.begin(), lowerStr.end(), lowerStr.begin(), ::tolower);
+    static constexpr char CacheMagic[8] = {'C', 'P', 'C', 'A', 'C', 'H', 'E', '\0'};
+    static constexpr uint32_t CacheVersion = 1;
+    static constexpr uint8_t CacheBinary = 0;
+    static constexpr uint8_t CacheText = 1;
 
+    // LbVt@C̐擪B (L[, l, , L[, l) ̕тƃ`FbNT
+    struct CacheHeader
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t count;
+        uint64_t sourceSize;
+        int64_t sourceTime;
+        uint64_t sourceHash;
+    };
 
-    if (transformer_) {
-      setter_(transformer_(str));
-    } else {
-      std::istringstream iss(str);
-      T temp;
-      iss >> temp;
-      setter_(temp);
+    static int64_t mtime(const char* path)
+    {
+        std::error_code ec;
+        auto time = std::filesystem::last_write_time(path, ec);
+        return ec ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
     }
-  }
 
-private:
-  std::string name_;
-  std::string defaultVal_;
-  std::string description_;
-  std::function<void(T)> setter_;
-  std::function<T()> getter_;
-  std::function<T(const std::string&)> transformer_;
-};
+    static CacheHeader source_header(const char* path, std::string_view content)
+    {
+        CacheHeader header = {};
+        std::memcpy(header.magic, CacheMagic, sizeof(header.magic));
+        header.version = CacheVersion;
+        header.sourceSize = content.size();
+        header.sourceTime = mtime(path);
+        header.sourceHash = config_detail::hash_key(content);
+        return header;
+    }
+
+    // \z̃TuR}h
+    struct PendingSubcommand
+    {
+        SubcommandFactory factory;
+        std::string description;
+    };
 
+    // ēǂݍݗpɕێO̐̒l
+    struct ReloadSlot
+    {
+        OptionBase* option = nullptr;
+        std::string raw;
+        bool known = false;
+        size_t last = 0;
+        ChangeCallback onChange;
+    };
 
+    std::pmr::memory_resource* resource_;
+    std::string name_;
+    std::string description_;
+    std::string delimiter_;
+    std::string partial_; // feed œr܂Ŏ󂯎s
+    size_t streamLine_ = 0;
+    DiagnosticSink diagnostics_;
+    config_detail::KeyTable keys_; // options_Efrozen_EeIvV̖O͂w
+    config_detail::Registry options_;
+    config_detail::FrozenTable<OptionBase> frozen_;
+    uint64_t generation_ = 0; // o^ς邽тɐiށiAsyncParse ̗vۂ𔻒fj
+    config_detail::KeyPath keyPath_;
+    std::unordered_map<std::string, std::unique_ptr<ConfigParser>> subcommands_;
+    std::unordered_map<std::string, PendingSubcommand> factories_;
+    ConfigParser* active_subcommand_ = nullptr;
+    ConfigParser* parent_ = nullptr;
+    std::string watchPath_;
+    config_detail::FileWatcher watcher_;
+    std::unordered_map<const OptionBase*, ReloadSlot> reload_;
+    std::vector<std::pair<ReloadSlot*, config_detail::ConfigEntry>> pending_;
+    std::unordered_map<OptionBase*, config_detail::ConfigEntry> lazy_; // ϊ̒l
+    std::vector<std::unique_ptr<config_detail::MappedFile>> lazyFiles_; // lazy_ wt@C
+#if defined(CONFIGPARSER_STATS)
+    ParseStats stats_;
+    AllocationCounter allocations_ = nullptr;
+#endif
+};
 
 // =======================
-// Parser {
+// StaticSchema (RpCXL[}AÓIfBXpb`)
 // =======================
-class ConfigParser 
+template<typename T>
+struct SchemaField
+{
+    std::string_view key;
+    uint64_t hash;
+    T* target;
+};
+
+/// L[̃nbV͒萔ŕ]ł
+template<typename T>
+constexpr SchemaField<T> field(std::string_view key, T& target)
+{
+    return SchemaField<T>{key, config_detail::hash_key(key), &target};
+}
+
+/// <summary>
+/// ^ttB[h̃^vBL[Ƃ̕ϊ悪RpCɌ܂̂ŁA
+/// zĂяoIvV{̂̃q[vmۂȂ
+/// </summary>
+template<typename... T>
+class StaticSchema
 {
 public:
+    constexpr explicit StaticSchema(SchemaField<T>... fields)
+      : fields_(fields...)
+    {}
+
     /// <summary>
-    /// Constructor
+    /// key ɈvtB[h value ϊď
     /// </summary>
-    /// <param name="delimiter">YAML̃f~^[':'ȊO\</param>
-    ConfigParser(std::string delimiter = ":"): delimiter_(delimiter)
-    {}
+    /// <returns>false: vtB[h</returns>
+    bool set(std::string_view key, std::string_view value) const
+    {
+        return dispatch(config_detail::hash_key(key), key, value, std::index_sequence_for<T...>());
+    }
 
     /// <summary>
-    /// IvVݒ
+    /// obt@p[XBo^L[͖
     /// </summary>
-    /// <typeparam name="T"></typeparam>
-    /// <param name="name"></param>
-    /// <param name="variable">xNg̏l^ꍇ͕ŗ</param>
-    /// <param name="description"></param>
-    /// <returns></returns>
-    template<typename T>
-    Option<T>* add_option(const std::string& name, T& variable, std::string description = "")
+    int parse_buffer(std::string_view text, std::string_view delimiter = ":") const
     {
-        auto opt = std::make_unique<Option<T>>(name, variable);
-        Option<T>* rawPtr = opt.get(); // `F[p
-        options_[name] = std::move(opt);
-        return rawPtr;
+        config_detail::LineScanner scanner(text, delimiter);
+        config_detail::ConfigEntry entry;
+        while (scanner.next(entry)) {
+            set(entry.key, entry.value);
+        }
+        return 0;
     }
 
-    template<typename T>
-    OptionFunc<T>* add_option_with_setter(
-      const std::string& name,
-      std::function<void(T)> setter,
-      std::function<T()> getter,
-      std::string description = "")
+    /// <returns>0: , -1: t@CJȂ</returns>
+    int parse(const char* configFile, std::string_view delimiter = ":") const
     {
-      auto opt = std::make_unique<OptionFunc<T>>(name, setter, getter);
-      OptionFunc<T>* rawPtr = opt.get();
-      options_[name] = std::move(opt);
-      return rawPtr;
+        config_detail::MappedFile file;
+        if (!file.open(configFile)) {
+            return -1;
+        }
+        return parse_buffer(file.view(), delimiter);
     }
 
     /// <summary>
-    /// YAML`̐ݒt@Cp[X
+    /// StB[hsp[T[̃IvVƂēo^
     /// </summary>
-    /// <param name="configFile"></param>
-    /// <returns></returns>
-    int parse(const char* configFile)
+    void register_with(ConfigParser& parser) const
     {
-        std::vector<std::string> lines;
+        std::apply([&](const auto&... f) {
+            (parser.add_option(f.key, *f.target), ...);
+        }, fields_);
+    }
 
-        std::ifstream file(configFile);
-        std::string line;
+private:
+    template<size_t... I>
+    bool dispatch(uint64_t hash, std::string_view key, std::string_view value,
+      std::index_sequence<I...>) const
+    {
+        return (assign(std::get<I>(fields_), hash, key, value) || ...);
+    }
 
-        while (std::getline(file, line)) {
-            // sRgsXLbv
-            if (line.empty() || line[0] == '#') {
-            continue;
-            } else if (line.size() == 1 && line[0] == ' ') {
-            // 1̍s͖
-            //continue;
-            }
+    template<typename U>
+    static bool assign(const SchemaField<U>& f, uint64_t hash, std::string_view key,
+      std::string_view value)
+    {
+        if (f.hash != hash || f.key != key) {
+            return false;
+        }
+        config_detail::assign_value(value, *f.target);
+        return true;
+    }
 
-            std::string arg_name, value;
+    std::tuple<SchemaField<T>...> fields_;
+};
 
-            size_t pos = line.find(delimiter_);
-            if (pos != std::string::npos) {
-            arg_name = line.substr(0, pos);
+// =======================
+// SnapshotParser (sσXibvVbgRCUJ)
+// =======================
+/// <summary>
+/// p[XʂV Config ɏ݁A|C^̕tւŌJB
+/// ǂݎ̓bN炸AɈтXibvVbgQƂł
+/// </summary>
+template<typename Config>
+class SnapshotParser
+{
+public:
+    /// ǂݎ蒆̃XibvVbgێBێ͋ł̉҂̂ŒZg
+    class Reader
+    {
+    public:
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
 
-            std::cout << arg_name << std::endl;
+        Reader(Reader&& other) noexcept
+          : config_(other.config_)
+          , counter_(other.counter_)
+        {
+            other.counter_ = nullptr;
+        }
 
-            value = line.substr(pos + delimiter_.length());
-            if (options_.count(arg_name)) {
-                options_[arg_name]->setValue(value);
-            }
+        ~Reader()
+        {
+            if (counter_) {
+                counter_->fetch_sub(1, std::memory_order_release);
             }
         }
-        return 0;
+
+        const Config& operator*() const
+        {
+            return *config_;
+        }
+
+        const Config* operator->() const
+        {
+            return config_;
+        }
+
+    private:
+        friend class SnapshotParser;
+
+        Reader(const Config* config, std::atomic<size_t>* counter)
+          : config_(config)
+          , counter_(counter)
+        {}
+
+        const Config* config_;
+        std::atomic<size_t>* counter_;
+    };
+
+    SnapshotParser(std::string delimiter = ":", const Config& initial = Config())
+      : parser_(delimiter)
+      , staging_(initial)
+      , current_(new Config(initial))
+    {}
+
+    SnapshotParser(const SnapshotParser&) = delete;
+    SnapshotParser& operator=(const SnapshotParser&) = delete;
+
+    ~SnapshotParser()
+    {
+        delete current_.load();
     }
 
-    // TuR}h
-    ConfigParser* add_subcommand(
-      const std::string& name, const std::string& description = "")
+    /// <summary>
+    /// Config ̃o[IvVƂēo^
+    /// </summary>
+    template<typename T>
+    Option<T>* add_option(std::string_view name, T Config::*member)
     {
-      auto sub = std::make_unique<ConfigParser>();
-      sub->name_ = name;
-      sub->description_ = description;
-      auto ptr = sub.get();
-      subcommands_[name] = std::move(sub);
-      return ptr;
+        return parser_.add_option(name, staging_.*member);
     }
 
-    // TuR}hANeBu
-    void parse_subcommand(const std::string& name)
+    ConfigParser& parser()
     {
-      if (subcommands_.count(name)) {
-        active_subcommand_ = subcommands_[name].get();
-      } else {
-        throw std::runtime_error("Unknown subcommand: " + name);
-      }
+        return parser_;
     }
 
-  protected:
-    void set(const std::string& name, const std::string& value)
+    /// <summary>
+    /// ݂̔ł𕡐ăp[XAVłƂČJB
+    /// sÔƂ͌Jς݂̔ł͂̂܂
+    /// </summary>
+    /// <returns>0: , -1: t@CJȂ</returns>
+    int parse(const char* configFile)
     {
-        if (options_.count(name)) {
-            options_[name]->setValue(value);
+        std::lock_guard<std::mutex> lock(writer_);
+        staging_ = *current_.load();
+        int result = parser_.parse(configFile);
+        if (result == 0) {
+            publish(new Config(std::move(staging_)));
         }
+        return result;
+    }
+
+    /// <summary>
+    /// ŐṼXibvVbg擾ibNȂj
+    /// </summary>
+    Reader read() const noexcept
+    {
+        std::atomic<size_t>& counter = readers_[epoch_.load() & 1];
+        counter.fetch_add(1);
+        return Reader(current_.load(), &counter);
     }
 
 private:
-    std::string name_;
-    std::string description_;
-    std::string delimiter_;
-    std::unordered_map<std::string, std::unique_ptr<OptionBase>> options_;
-    std::unordered_map<std::string, std::unique_ptr<ConfigParser>> subcommands_;
-    ConfigParser* active_subcommand_ = nullptr;
+    void publish(const Config* next)
+    {
+        const Config* old = current_.exchange(next);
+        // 2؂ւAłQƂ\̂ǂݎ肪ȂȂ܂ő҂
+        for (int i = 0; i < 2; ++i) {
+            unsigned epoch = epoch_.fetch_add(1);
+            while (readers_[epoch & 1].load() != 0) {
+                std::this_thread::yield();
+            }
+        }
+        delete old;
+    }
+
+    ConfigParser parser_;
+    Config staging_;
+    std::atomic<const Config*> current_;
+    std::atomic<unsigned> epoch_{0};
+    mutable std::atomic<size_t> readers_[2] = {};
+    std::mutex writer_;
 };
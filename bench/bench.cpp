@@ -0,0 +1,90 @@
+#include "ConfigParser.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Count every heap allocation made by the process
+static size_t g_allocs = 0;
+void* operator new(size_t n)
+{
+  ++g_allocs;
+  if (void* p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+enum class Mode { Slow, Fast };
+
+struct Result { double seconds; size_t allocs; };
+
+template<typename F>
+Result measure(F&& f, int repeat)
+{
+  size_t before = g_allocs;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repeat; ++i)
+    f();
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return { elapsed.count() / repeat, (g_allocs - before) / repeat };
+}
+
+void report(const char* name, Result r, size_t lines, size_t bytes)
+{
+  std::printf("%-24s %12.0f items/s %8.1f MB/s %8.3f allocs/line\n", name,
+    lines / r.seconds, bytes / r.seconds / 1e6, double(r.allocs) / lines);
+}
+
+int main()
+{
+  for (size_t keys : { 100, 2000, 50000 }) {
+    // scalar, vector, enum and setter options, one line each per key
+    std::vector<int> scalars(keys);
+    std::vector<std::vector<float>> vectors(keys);
+    std::vector<Mode> modes(keys);
+    int last = 0;
+    std::string text, miss;
+    ConfigParser parser;
+    for (size_t i = 0; i < keys; ++i) {
+      std::string k = std::to_string(i);
+      parser.add_option("scalar" + k, scalars[i]);
+      parser.add_option("vector" + k, vectors[i]);
+      parser.add_option("mode" + k, modes[i]);
+      parser.add_option_with_setter<int>("func" + k,
+        [&](int v) { last = v; }, [&] { return last; });
+      std::string lines = "scalar" + k + ": " + k + "\n"
+        + "vector" + k + ": 1.5,2.5,3.5,4.5,5.5,6.5,7.5,8.5\n"
+        + "mode" + k + ": 1\n"
+        + "func" + k + ": " + k + "\n";
+      text += lines;
+      miss += "x" + lines; // unregistered key: scan + lookup only
+    }
+    size_t lines = keys * 4;
+    std::ofstream("bench.yaml") << text;
+    std::ofstream("bench_miss.yaml") << miss;
+
+    int repeat = keys < 1000 ? 200 : 5;
+    std::printf("--- %zu keys, %zu lines, %.1f MB ---\n", keys, lines, text.size() / 1e6);
+    report("parse", measure([&] { parser.parse("bench.yaml"); }, repeat), lines, text.size());
+    report("parse (lookup only)", measure([&] { parser.parse("bench_miss.yaml"); }, repeat),
+      lines, miss.size());
+
+    // conversion only: call setValue on the registered options directly
+    std::string_view list = "1.5,2.5,3.5,4.5,5.5,6.5,7.5,8.5";
+    OptionBase* scalar = parser.add_option("s", scalars[0]);
+    OptionBase* vector = parser.add_option("v", vectors[0]);
+    OptionBase* mode = parser.add_option("m", modes[0]);
+    OptionBase* func = parser.add_option_with_setter<int>("f",
+      [&](int v) { last = v; }, [&] { return last; });
+    auto each = [&](OptionBase* opt, std::string_view value) {
+      return measure([&] { for (size_t i = 0; i < keys; ++i) opt->setValue(value); }, repeat);
+    };
+    report("setValue int", each(scalar, "12345"), keys, keys * 5);
+    report("setValue vector<float>", each(vector, list), keys, keys * list.size());
+    report("setValue enum", each(mode, "1"), keys, keys);
+    report("setValue OptionFunc", each(func, "12345"), keys, keys * 5);
+  }
+  return 0;
+}
@@ -0,0 +1,175 @@
+#include "ConfigParser.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <tuple>
+
+// Differential checks run by `make check`: each fast path is compared with the plain one it replaces.
+
+static int g_failures = 0;
+
+static void fail(const char* what, const std::string& input)
+{
+  ++g_failures;
+  std::printf("FAIL %s: \"%s\"\n", what, input.c_str());
+}
+
+// try_parse_list without the batch kernel: split on ',' and convert each element with Converter<T>
+template<typename T>
+static bool reference_list(std::string_view str, std::vector<T>& out, std::string_view& bad)
+{
+  out.clear();
+  size_t pos = 0;
+  while (pos < str.size()) {
+    size_t comma = std::min(str.find(',', pos), str.size());
+    std::string_view token = str.substr(pos, comma - pos);
+    pos = comma + 1;
+    T val{};
+    if (!config_detail::Converter<T>::parse(token, val)) {
+      bad = token;
+      return false;
+    }
+    out.push_back(val);
+  }
+  return true;
+}
+
+template<typename T>
+static bool same(const std::vector<T>& a, const std::vector<T>& b)
+{
+  if constexpr (std::is_floating_point<T>::value) {
+    // NaN and -0 must survive too, so compare the bits
+    return a.size() == b.size()
+      && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+  } else {
+    return a == b;
+  }
+}
+
+template<typename T>
+static void check_list(const char* type)
+{
+  static const char* const inputs[] = {
+    "", ",", ",,", "1", "1,", "1,,", ",1", "1,,2", " 1 , 2 ", "\t1\t,\t2\t", "1 2", " , ",
+    "+1", "-1", "-0", "+0", "-", "+", "+-1", "--1", "1-", "0x10", "010", "1.5", ".5", "5.", "1e3", "1e", "e1",
+    "127,128,-128,-129", "255,256", "32767,32768,-32768,-32769", "65535,65536",
+    "2147483647,2147483648,-2147483648,-2147483649", "4294967295,4294967296",
+    "9223372036854775807,9223372036854775808,-9223372036854775808,-9223372036854775809",
+    "18446744073709551615,18446744073709551616", "99999999999999999999999999999999",
+    "00000000000000000000000000000001", "1e38,1e39,-1e39", "1e308,1e309,-1e309", "1e-400",
+    "inf,-inf,nan,NAN,infinity", "0.1,0.2,0.3", "3.4028235e38", "1.7976931348623157e308",
+    "4.9e-324,2.2250738585072014e-308", "1,2,x", "x", "1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17",
+  };
+  for (const char* input : inputs) {
+    std::vector<T> fast, slow;
+    std::string_view badFast, badSlow;
+    bool okFast = config_detail::try_parse_list(input, fast, 0, badFast);
+    bool okSlow = reference_list<T>(input, slow, badSlow);
+    if (okFast != okSlow || (okFast && !same(fast, slow))
+      || (!okFast && (badFast.data() != badSlow.data() || badFast.size() != badSlow.size()))) {
+      fail(type, input);
+    }
+  }
+}
+
+using Diagnostic = std::tuple<ParseDiagnostic::Kind, size_t, std::string, std::string>;
+
+// parse_parallel / parse_layers split files at line boundaries; the split must not change any result
+static void check_split()
+{
+  static const char* const fillers[] = {
+    "\n", "\r\n", "# note: 1\n", "  # indented: 1\n", "no delimiter\n", "  \n", "  unknown: 1\r\n",
+  };
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "configparser_check.yaml";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "top: 1\n";
+    for (int i = 0; i < 3000; ++i) {
+      out << (i % 2 ? "server:\r\n" : "server:\n");
+      out << "  a" << i % 50 << ": " << i << "\n";
+      for (int j = 0; j < 40; ++j) {
+        out << fillers[(i + j) % 7] << "  pad: " << j << (j % 3 ? "\n" : "\r\n");
+      }
+      out << "top" << ": " << i << "\n";
+    }
+  }
+  std::vector<int> values[3];
+  std::vector<int> calls[3];
+  std::vector<Diagnostic> diagnostics[3];
+  for (int mode = 0; mode < 3; ++mode) {
+    values[mode].assign(52, -1);
+    ConfigParser parser;
+    parser.set_diagnostics([&, mode](const ParseDiagnostic& d) {
+      diagnostics[mode].emplace_back(d.kind, d.line, std::string(d.key), std::string(d.value));
+    });
+    for (int i = 0; i < 50; ++i)
+      parser.add_option("server.a" + std::to_string(i), values[mode][i]);
+    parser.add_option_with_setter<int>("server.pad",
+      [&, mode](int v) { values[mode][50] = v; calls[mode].push_back(v); },
+      [&, mode] { return values[mode][50]; });
+    parser.add_option("top", values[mode][51]);
+    if (mode == 0) parser.parse(path.string().c_str());
+    else if (mode == 1) parser.parse_parallel(path.string().c_str(), 8);
+    else parser.parse_layers({ path.string() }, 8);
+  }
+  std::filesystem::remove(path);
+  if (diagnostics[0].empty() || calls[0].empty()) fail("parse saw no input", path.string());
+  for (int mode = 1; mode < 3; ++mode) {
+    const char* name = mode == 1 ? "parse_parallel" : "parse_layers";
+    if (values[mode] != values[0]) fail("values differ from parse", name);
+    if (calls[mode] != calls[0]) fail("setter calls differ from parse", name);
+    if (diagnostics[mode] != diagnostics[0]) fail("diagnostics differ from parse", name);
+  }
+}
+
+// re-registering a key destroys the old option; nothing recorded for it may be used afterwards (ASan)
+static void check_replace()
+{
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "configparser_replace.yaml";
+  { std::ofstream out(path, std::ios::binary); out << "a: 1\nrun:\n  y: 2\n"; }
+  int a1 = 0, a2 = 0, y1 = 0, y2 = 0, changed = 0;
+  ConfigParser parser;
+  parser.add_option("a", a1);
+  ConfigParser* run = parser.add_subcommand("run");
+  run->add_option("y", y1);
+  parser.on_change("a", [&](std::string_view) { ++changed; });
+  parser.watch(path.string().c_str());
+  parser.add_option("a", a2);
+  if (parser.reload() != 1 || a2 != 1 || changed != 2) fail("reload after re-registering", "a");
+
+  y1 = 0;
+  parser.parse_lazy(path.string().c_str());
+  auto lazy = parser.lazy<int>("run.y");
+  run->add_option("y", y2);
+  if (lazy.get() != 2 || y2 != 2 || y1 != 0) fail("materialize after re-registering", "run.y");
+  std::string s;
+  run->add_option("y", s);
+  bool threw = false;
+  try {
+    lazy.get();
+  } catch (const std::runtime_error&) {
+    threw = true;
+  }
+  if (!threw) fail("type change after re-registering", "run.y");
+  parser.materialize_all();
+  std::filesystem::remove(path);
+}
+
+int main()
+{
+  check_list<short>("short");
+  check_list<unsigned short>("unsigned short");
+  check_list<int>("int");
+  check_list<unsigned>("unsigned");
+  check_list<long long>("long long");
+  check_list<unsigned long long>("unsigned long long");
+  check_list<float>("float");
+  check_list<double>("double");
+  check_split();
+  check_replace();
+  if (g_failures == 0) {
+    std::printf("check: ok\n");
+  }
+  return g_failures == 0 ? 0 : 1;
+}
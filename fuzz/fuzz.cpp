@@ -0,0 +1,33 @@
+#include "ConfigParser.hpp"
+#include <cstddef>
+#include <cstdint>
+
+enum class Mode { Slow, Fast };
+
+// libFuzzer entry point: any input must either parse or throw std::runtime_error
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  static int scalar;
+  static double real;
+  static std::string text;
+  static std::vector<int> list;
+  static Mode mode;
+  static ConfigParser* parser = [] {
+    auto* p = new ConfigParser;
+    p->add_option("scalar", scalar);
+    p->add_option("real", real);
+    p->add_option("text", text);
+    p->add_option("list", list);
+    p->add_option("mode", mode);
+    p->add_subcommand("sub")->add_option("scalar", scalar);
+    return p;
+  }();
+
+  std::string_view input(reinterpret_cast<const char*>(data), size);
+  try {
+    parser->parse_buffer(input);
+  } catch (const std::runtime_error&) {
+  }
+  parser->validate_buffer(input); // non-throwing path must not throw
+  return 0;
+}
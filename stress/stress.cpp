@@ -0,0 +1,153 @@
+#include "ConfigParser.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static size_t g_allocs = 0;
+void* operator new(size_t n)
+{
+  ++g_allocs;
+  if (void* p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static long peak_kb()
+{
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss; // KB on Linux
+}
+
+// One input class: writes an input of scale n to out
+struct Input {
+  const char* name;
+  size_t base;
+  void (*write)(std::ofstream& out, size_t n);
+};
+
+const Input inputs[] = {
+  { "lines", 125000, [](std::ofstream& out, size_t n) {
+      for (size_t i = 0; i < n; ++i) out << "key" << i % 1024 << ": " << i << "\n";
+    } },
+  { "crlf", 125000, [](std::ofstream& out, size_t n) {
+      for (size_t i = 0; i < n; ++i) out << "key" << i % 1024 << ": " << i << "\r\n";
+    } },
+  { "long vector", 125000, [](std::ofstream& out, size_t n) {
+      out << "list: ";
+      for (size_t i = 0; i < n; ++i) out << (i ? "," : "") << 100000 + i % 900000;
+      out << "\n";
+    } },
+  { "long keys", 65536, [](std::ofstream& out, size_t n) {
+      for (int i = 0; i < 16; ++i) out << std::string(n, char('a' + i)) << ": 1\n";
+    } },
+};
+
+struct Sample { size_t bytes; double seconds; size_t allocs; long rssKb; };
+
+// Parse in a forked child so each sample gets its own peak RSS
+Sample run(const char* path, size_t bytes, const char* entry)
+{
+  int fds[2];
+  if (pipe(fds) != 0) std::exit(1);
+  if (fork() == 0) {
+    std::vector<int> scalars(1024), list;
+    ConfigParser parser;
+    for (size_t i = 0; i < scalars.size(); ++i)
+      parser.add_option("key" + std::to_string(i), scalars[i]);
+    parser.add_option("list", list);
+    parser.freeze();
+    long before = peak_kb();
+    size_t allocs = g_allocs;
+    auto start = std::chrono::steady_clock::now();
+    if (!std::strcmp(entry, "lazy")) parser.parse_lazy(path), parser.materialize_all();
+    else if (!std::strcmp(entry, "parallel")) parser.parse_parallel(path);
+    else parser.parse(path);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    Sample s = { bytes, elapsed.count(), g_allocs - allocs, peak_kb() - before };
+    (void)!write(fds[1], &s, sizeof(s));
+    _exit(0);
+  }
+  Sample s = {};
+  (void)!read(fds[0], &s, sizeof(s));
+  wait(nullptr);
+  close(fds[0]);
+  close(fds[1]);
+  return s;
+}
+
+// parse, parse_parallel and parse_layers must agree on a large nested section
+// interrupted by lines the scanner skips (the chunk splitter must not cut there)
+bool check_equivalence()
+{
+  for (const char* filler : { "\n", "\r\n", "# note\n", "no delimiter\n" }) {
+    {
+      std::ofstream out("stress_sections.yaml", std::ios::binary);
+      out << "top: 1\nserver:\n";
+      for (int i = 0; i < 50; ++i) {
+        out << "  a" << i << ": " << i << "\n";
+        for (int j = 0; j < 2000; ++j) out << filler << "  pad: " << j << "\n";
+      }
+      out << "top: 2\n";
+    }
+    std::vector<int> values[3];
+    std::vector<int> calls[3]; // OptionFunc sees every occurrence, in file order
+    size_t unknown[3] = {};
+    for (int mode = 0; mode < 3; ++mode) {
+      values[mode].assign(52, -1);
+      ConfigParser parser;
+      parser.set_diagnostics([&](const ParseDiagnostic&) { ++unknown[mode]; });
+      for (int i = 0; i < 50; ++i)
+        parser.add_option("server.a" + std::to_string(i), values[mode][i]);
+      parser.add_option_with_setter<int>("server.pad",
+        [&, mode](int v) { values[mode][50] = v; calls[mode].push_back(v); },
+        [&, mode] { return values[mode][50]; });
+      parser.add_option("top", values[mode][51]);
+      if (mode == 0) parser.parse("stress_sections.yaml");
+      else if (mode == 1) parser.parse_parallel("stress_sections.yaml", 8);
+      else parser.parse_layers({ "stress_sections.yaml" }, 8);
+    }
+    if (values[0] != values[1] || values[0] != values[2]
+      || calls[0] != calls[1] || calls[0] != calls[2]
+      || unknown[0] != unknown[1] || unknown[0] != unknown[2]) {
+      std::printf("MISMATCH parse vs parse_parallel/parse_layers (filler %s)\n",
+        filler[0] == '#' ? "comment" : filler[0] == 'n' ? "line without delimiter" : "blank line");
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  if (!check_equivalence())
+    return 1;
+  const char* entry = argc > 1 ? argv[1] : "parse"; // parse | lazy | parallel
+  std::printf("%-12s %10s %10s %10s %12s %10s\n", "class", "MB", "MB/s", "allocs/KB", "peak RSS KB", "");
+  for (const Input& input : inputs) {
+    Sample first = {};
+    for (size_t scale = 1; scale <= 8; scale *= 2) {
+      { std::ofstream out("stress.yaml", std::ios::binary); input.write(out, input.base * scale); }
+      size_t bytes = std::filesystem::file_size("stress.yaml");
+      Sample s = run("stress.yaml", bytes, entry);
+      if (scale == 1) first = s;
+      // cost per byte should stay flat as the input doubles; flag >2x growth
+      double growth = bytes / double(first.bytes);
+      bool slow = s.seconds / first.seconds > 2 * growth;
+      bool allocs = s.allocs > 2 * growth * (first.allocs + 16);
+      bool memory = s.rssKb > 2 * growth * (first.rssKb + 1024);
+      std::printf("%-12s %10.2f %10.1f %10.3f %12ld %s%s%s\n", input.name, bytes / 1e6,
+        bytes / s.seconds / 1e6, s.allocs * 1024.0 / bytes, s.rssKb,
+        slow ? " SUPER-LINEAR time" : "", allocs ? " SUPER-LINEAR allocs" : "",
+        memory ? " SUPER-LINEAR memory" : "");
+    }
+  }
+  return 0;
+}